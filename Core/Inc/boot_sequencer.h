@@ -0,0 +1,44 @@
+#ifndef BOOT_SEQUENCER_H
+#define BOOT_SEQUENCER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Açılış sırası ve süre profili.
+// SDRAM kernel başlamadan main'de, LCD DisplayTask'ta, kamera CameraTask'ta paralel açılır.
+// Sürücülerin datasheet beklemeleri bootDelayMs ile yapılır: kernel çalışıyorsa osDelay ile
+// uyunur ve CPU diğer açılışa kalır. Her aşamanın başlangıç/bitişi DWT döngüsü olarak kaydedilir,
+// sonuçlar debugger'dan okunur.
+#define BOOT_FIRST_FRAME_BUDGET_MS  500   // Reset -> ilk kare ekranda
+
+typedef enum {
+    BOOT_STAGE_SDRAM,        // FMC komut dizisi + self-test
+    BOOT_STAGE_LCD,          // ILI9341 reset + init komutları
+    BOOT_STAGE_CAMERA,       // OV7670 SCCB ayarı + DCMI/DMA
+    BOOT_STAGE_FIRST_FRAME,  // Profil başlangıcından ilk karenin ekrana yazılmasına kadar
+    BOOT_STAGE_COUNT
+} BootStage;
+
+typedef struct {
+    uint32_t start_tick;                    // bootProfileBegin anındaki HAL tick (HAL_Init'ten beri ms)
+    uint32_t origin;                        // bootProfileBegin anındaki DWT sayacı
+    uint32_t stage_start[BOOT_STAGE_COUNT]; // origin'e göre döngü
+    uint32_t stage_end[BOOT_STAGE_COUNT];
+    volatile bool stage_done[BOOT_STAGE_COUNT];  // Aşamalar farklı görevlerde biter, bayraklar ayrı
+} BootProfile;
+
+// Profili sıfırlar ve zaman başlangıcını alır. DWT sayacı açık olmalı (frameTimestampInit).
+void bootProfileBegin(BootProfile *boot);
+void bootStageBegin(BootProfile *boot, BootStage stage);
+// Aşamanın ilk bitişini kaydeder, sonraki çağrılar yok sayılır (ör. her gösterilen kare)
+void bootStageEnd(BootProfile *boot, BootStage stage);
+bool bootStageDone(const BootProfile *boot, BootStage stage);
+// Aşamanın kendi süresi (döngü), bitmediyse 0
+uint32_t bootStageCycles(const BootProfile *boot, BootStage stage);
+// Aşamanın bittiği an, HAL_Init'ten beri ms. Bitmediyse 0.
+uint32_t bootStageReadyMs(const BootProfile *boot, BootStage stage);
+
+// En az ms milisaniye bekler. Kernel çalışıyorsa görev uyur, öncesinde HAL_Delay.
+void bootDelayMs(uint32_t ms);
+
+#endif // BOOT_SEQUENCER_H
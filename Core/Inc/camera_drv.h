@@ -22,15 +22,56 @@ typedef enum {
 
 te_CAMERA_ERROR_CODES Camera_Open(void);
 
+// Double-buffered capture: DMA2_Stream1 alternates between two frame buffers (M0AR/M1AR).
+// Each buffer must hold CAMERA_FRAME_WORDS 32-bit words (one RGB565 frame).
+te_CAMERA_ERROR_CODES Camera_StartCapture(uint16_t *buffer0, uint16_t *buffer1);
+
+// Called from the DMA interrupt when a buffer holds a complete frame. The DMA is already
+// filling the other buffer. Return the buffer to fill next in this slot; the completed frame
+// then belongs to the caller and is never touched by the DMA again. Returning `frame` itself
+// reuses it (the frame is dropped). Weak default: always reuse.
+// vsync_time is the DWT cycle count at the VSYNC that started this frame (DWT must be enabled).
+uint16_t *Camera_FrameCompleteCallback(uint16_t *frame, uint32_t vsync_time);
+
+// Called from the DCMI line interrupt every CAMERA_STRIP_ROWS rows while `frame` is still being
+// filled: its first rows_ready rows are in memory. The buffer still belongs to the DMA; the last
+// strip is reported by Camera_FrameCompleteCallback. Weak default: ignore.
+void Camera_StripCompleteCallback(uint16_t *frame, uint16_t rows_ready, uint32_t vsync_time);
+
+// Called from the DCMI/DMA interrupt when capture is restarted after an error. The frame being
+// filled is abandoned: the buffers are refilled from row 0 and its strips start over, so anything
+// already reported for it must not be continued. Weak default: ignore.
+void Camera_CaptureRestartCallback(void);
+
+// DMA transfer errors and DCMI sync/overflow errors since start; capture is restarted on each
+uint32_t Camera_GetErrorCount(void);
+
+// DCMI frame capture rate: DCMI_CR_ALL_FRAME, DCMI_CR_ALTERNATE_2_FRAME or DCMI_CR_ALTERNATE_4_FRAME.
+// Applied at the next VSYNC. Skipped sensor frames produce no DMA transfer and no callbacks.
+void Camera_SetCaptureRate(uint32_t capture_rate);
+
+// Waits used by Camera_Open (sensor register reset), at least ms milliseconds.
+// Weak default: HAL_Delay. Override it to sleep instead.
+void Camera_DelayMs(uint32_t ms);
+
 #define SCCB_REG_ADDR 			0x01
 
 // OV7670 camera settings
 #define OV7670_REG_NUM 			122
 #define OV7670_WRITE_ADDR 	0x42
+#define OV7670_COM7				0x12
+#define OV7670_COM7_RESET		0x80	// Resets all registers to default values
+#define OV7670_RESET_WAIT_MS	1		// Register reset settling time
+
+// Image settings: frame geometry as delivered by DCMI: 320 pixels per line, 240 lines (row-major)
+#define IMG_WIDTH   			320
+#define IMG_HEIGHT   			240
+
+// DMA transfer size of one frame (two RGB565 pixels per word)
+#define CAMERA_FRAME_WORDS		(IMG_WIDTH * IMG_HEIGHT / 2)
 
-// Image settings
-#define IMG_ROWS   			    320
-#define IMG_COLUMNS   			240
+// Rows per strip notification while a frame is being captured
+#define CAMERA_STRIP_ROWS		16
 
 
 
@@ -0,0 +1,38 @@
+#ifndef DAMAGE_H
+#define DAMAGE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Bir çıkış karesinin önceki çıkışa göre değişen bölgeleri (dirty rectangle listesi).
+// Filtre değişen dikdörtgenleri bildirir; kesişen veya bitişik olanlar birleştirilir, liste
+// dolunca alanı en az büyütecek çift birleştirilir. Toplam alan karenin DAMAGE_FULL_PERCENT'ini
+// geçerse tüm kare değişmiş sayılır: tek parça tam kare yazmak çok sayıda pencereden ucuzdur.
+#define DAMAGE_MAX_RECTS     8
+#define DAMAGE_FULL_PERCENT  60
+
+typedef struct {
+    uint16_t x;
+    uint16_t y;
+    uint16_t width;
+    uint16_t height;
+} DamageRect;
+
+typedef struct {
+    DamageRect rects[DAMAGE_MAX_RECTS];  // Birbirine değmeyen dikdörtgenler
+    uint8_t count;
+    bool full;                           // Tüm kare değişti, rects kullanılmaz
+    uint16_t width;                      // Kare boyutu, dikdörtgenler buna kırpılır
+    uint16_t height;
+} DamageList;
+
+// Boş liste: hiçbir piksel değişmedi
+void damageClear(DamageList *damage, uint16_t width, uint16_t height);
+// Tüm kare değişti (ilk kare, geçmişsiz filtreler)
+void damageSetFull(DamageList *damage, uint16_t width, uint16_t height);
+// (x, y) konumundan width x height bölgesi değişti; kare dışına taşan kısım kırpılır
+void damageAdd(DamageList *damage, int x, int y, int width, int height);
+// Değişen piksel sayısı (full ise tüm kare)
+uint32_t damageArea(const DamageList *damage);
+
+#endif // DAMAGE_H
@@ -3,10 +3,12 @@
 
 #include <stdint.h>
 #include <stdbool.h>
+#include "image_view.h"
+#include "damage.h"
 
 // ROI optimizasyon ayarları
 #define ROI_OPT_BLOCK_SIZE 32  // ROI blok boyutu
-#define ROI_OPT_THRESHOLD 0   // Değişim algılama eşiği
+#define ROI_OPT_THRESHOLD 1   // Değişim algılama eşiği (piksel başına ortalama luma farkı, 0: birebir sonuç)
 
 #define ROI_TH 0
 #define ROI_WIDTH 5
@@ -18,6 +20,21 @@
 #define ALARM_COLOR 0xF800  // Kırmızı renk (RGB565 formatında)
 #define ALARM_DURATION_MS 1000 // Alarm süresi (ms)
 
+// Filtrelerin kabul ettiği en büyük görüntü (iç tamponlar bu boyuta göre ayrılır)
+#define FILTER_MAX_WIDTH  320
+#define FILTER_MAX_HEIGHT 240
+#define FILTER_MAX_PIXELS (FILTER_MAX_WIDTH * FILTER_MAX_HEIGHT)
+
+// En büyük görüntüdeki ROI optimizasyon bloğu sayısı
+#define ROI_OPT_MAX_BLOCKS (((FILTER_MAX_WIDTH + ROI_OPT_BLOCK_SIZE - 1) / ROI_OPT_BLOCK_SIZE) * \
+                            ((FILTER_MAX_HEIGHT + ROI_OPT_BLOCK_SIZE - 1) / ROI_OPT_BLOCK_SIZE))
+
+// Context başına en fazla luma geçmiş düzlemi (mevcut kare dahil)
+#define FILTER_HISTORY_DEPTH 4
+
+// Ayrık Gaussian için en büyük binom kernel boyutu
+#define GAUSSIAN_MAX_SIZE 7
+
 typedef enum {
     FILTER_NONE,
     FILTER_LAPLACIAN,
@@ -27,25 +44,125 @@ typedef enum {
     FILTER_ROI_CENTER_ALARM
 } FilterType;
 
+#define FILTER_TYPE_COUNT (FILTER_ROI_CENTER_ALARM + 1)
+
+// Kernel filtrelerinin (Laplacian, Gaussian) işlem kalitesi, kare süresi bütçeyi aşınca düşürülür
+typedef enum {
+    FILTER_QUALITY_FULL,
+    FILTER_QUALITY_HALF_ROWS,   // Kernel her 2 satırdan birinde çalışır, satırlar tekrarlanır
+    FILTER_QUALITY_HALF_RES     // Kernel yarım çözünürlüklü luma düzleminde, çıkış 2x büyütülür
+} FilterQuality;
+
+// Çıkış karesine boyanmadan doğrudan panele çizilecek düz renkli dikdörtgen (merkez ROI alarmı)
+typedef struct {
+    DamageRect rect;
+    uint16_t color;             // RGB565
+    bool active;
+} FilterOverlay;
+
+// Bir filtre örneğinin tüm durumu: ayarlar, geçmiş kare, alarm zamanlayıcısı ve çalışma tamponları.
+// Her analiz örneği kendi context'ini kullanır, böylece aynı kare akışında birden fazla
+// örnek farklı hızlarda çalışabilir. Geçmiş tamponları çağıran tarafından verilir (genelde SDRAM).
+typedef struct {
+    // Ayarlar
+    int gaussian_size;          // FILTER_GAUSSIAN binom kernel boyutu (3, 5, 7)
+    bool roi_optimization;      // ROI optimizasyon flag'i
+    FilterQuality quality;      // Kernel kalitesi, FULL dışında artımlı işleme ve şerit modu kullanılmaz
+    bool panel_overlay;         // Alarm rengi çıkışa boyanmaz, overlay ile bildirilir
+
+    // Luma geçmiş halkası (FILTER_ROI, FILTER_ROI_CENTER_ALARM, artımlı kernel'ler).
+    // Her kare sıradaki yuvaya yazılır, kopyalama yerine head indeksi döner.
+    uint8_t *luma_ring[FILTER_HISTORY_DEPTH];
+    uint32_t luma_ring_plane_size;  // Yuva başına byte
+    uint8_t luma_ring_depth;        // Kullanılan yuva sayısı
+    uint8_t luma_ring_head;         // En yeni karenin yuvası
+    uint8_t luma_ring_frames;       // Geriye bakılabilecek kare sayısı (en fazla depth - 1)
+    uint16_t luma_ring_width;       // Halkadaki karelerin boyutu
+    uint16_t luma_ring_height;
+    FilterType last_filter;     // Son çalışan filtre, değişince geçmiş silinir
+
+    // Merkez ROI alarmı
+    bool alarm_active;          // Alarm durumu
+    uint32_t alarm_start_time;  // Alarm başlangıç zamanı (tick)
+
+    // Artımlı işleme (ROI optimizasyonu)
+    ImageView last_output;      // Son kernel çıkışı, sadece has_output ise geçerli
+    bool has_output;            // last_output bir sonraki karede yeniden kullanılabilir (çağıran belleği
+                                // bir sonraki çağrıya kadar değiştirmemeli)
+    uint16_t changed_blocks;    // Son karede yeniden hesaplanan blok sayısı
+    uint8_t block_map[ROI_OPT_MAX_BLOCKS];  // Blok değişim haritası (1: değişti)
+
+    // Son çıkışın bir önceki çıkışa (last_output) göre değişen bölgeleri. FILTER_ROI ve ROI
+    // optimizasyonlu kernel'ler değişen pencereleri bildirir, diğer her durumda tüm kare.
+    DamageList damage;
+
+    // Son karenin panel overlay'i (sadece panel_overlay açıkken). Tüm kareyi kaplıyorsa çıkış yazılmaz.
+    FilterOverlay overlay;
+
+    // Şerit modu (filterStripBegin/filterStripProcess)
+    ImageView strip_input;
+    ImageView strip_output;
+    ImageView strip_plane;      // Kernel'ler için luma düzlemi, satırlar geldikçe dolar
+    FilterType strip_filter;
+    uint8_t strip_border;       // Kernel yarıçapı, çıkış girişin bu kadar satır gerisinde
+    uint16_t strip_rows_in;     // İşlenen giriş satırı (üstten)
+    uint16_t strip_rows_out;    // Tamamlanan çıkış satırı (üstten)
+    bool strip_loaded;          // strip_plane geçmiş halkasının yuvası
+    bool strip_active;
+
+    // Çalışma tamponları
+    uint16_t blur_rows[GAUSSIAN_MAX_SIZE][FILTER_MAX_WIDTH];  // Ayrık Gaussian kayan satır tamponu
+} FilterContext;
+
+void filterContextInit(FilterContext *ctx, uint8_t *luma_planes, uint32_t plane_size, uint8_t plane_count);
+void filterContextReset(FilterContext *ctx);
+
 extern const int laplacian_kernel[3][3];
 extern const int gaussian_kernel[3][3];
 extern const int gaussian_factor;
 
 void applyKernel3x3_window(uint8_t window[3][3], const int kernel[3][3], int kernel_factor, int *result);
-void applyFilterToImage(uint16_t *input_image, uint16_t *output_image, FilterType filter_type);
-void applyFilterToImageFull(uint16_t *input_image, uint16_t *output_image, FilterType filter_type);
-
-// Filtre testlerini çalıştıran ana fonksiyon
-void runFilterTests(void);
-static void testCenterROIAlarm(void);
-static void createTestImage(uint16_t *image, int pattern);
-static int compareImages(uint16_t *img1, uint16_t *img2, int size);
-static void testGrayscaleFilter(void);
-static void testLaplacianFilter(void);
-static void testROIOptimization(void);
-static void testCenterROIAlarm(void);
+// plane: Y8, output: RGB565, aynı boyutta
+void convolveLaplacian3x3(const ImageView *plane, const ImageView *output);
+void gaussianBlurSeparable(const ImageView *plane, const ImageView *output, int size,
+                           uint16_t rows_buffer[GAUSSIAN_MAX_SIZE][FILTER_MAX_WIDTH]);
+// input: RGB565 veya Y8, output: RGB565, aynı boyutta (en fazla FILTER_MAX_WIDTH x FILTER_MAX_HEIGHT)
+void applyFilterToImage(const ImageView *input, const ImageView *output, FilterType filter_type);
+void applyFilterToImageFull(FilterContext *ctx, const ImageView *input, const ImageView *output, FilterType filter_type);
+
+// Filtre girişi değiştirmiyorsa (FILTER_NONE) true: çağıran çıkışa kopyalamak yerine giriş karesini
+// iletir. Context bu kareyi görmüş sayılır (filtre değişimi applyFilterToImageFull'daki gibi işlenir).
+bool filterPassthrough(FilterContext *ctx, FilterType filter_type);
+
+// Filtre değişiminden önce son tam kareyle çağrılır: filter_type yeni ise context sıfırlanır ve
+// önceki kareye bakan filtrelerin (ROI, ROI alarm, ROI optimizasyonlu kernel'ler) geçmişine
+// input yazılır. Böylece yeni filtrenin ilk karesi "ilk kare" olarak harcanmaz.
+void filterPrime(FilterContext *ctx, const ImageView *input, FilterType filter_type);
+
+// Şerit modu: giriş üstten alta doldukça filtreler. Sadece FILTER_NONE, FILTER_GRAYSCALE ve ROI
+// optimizasyonu kapalı, kalite FULL iken kernel filtreleri desteklenir; diğerleri için false, çağıran
+// kare tamamlanınca applyFilterToImageFull kullanır. Giriş ve çıkış kare bitene kadar geçerli kalmalı.
+bool filterStripBegin(FilterContext *ctx, const ImageView *input, const ImageView *output, FilterType filter_type);
+// Girişin üstten rows_ready satırı hazır; yeni satırları işler ve tamamlanan çıkış satır sayısını döner.
+// rows_ready == height ile kare biter.
+uint16_t filterStripProcess(FilterContext *ctx, uint16_t rows_ready);
+
 // ROI optimizasyon kontrolü için fonksiyonlar
-void setROIOptimizationEnabled(bool enabled);
-bool isROIOptimizationEnabled(void);
+void setROIOptimizationEnabled(FilterContext *ctx, bool enabled);
+bool isROIOptimizationEnabled(const FilterContext *ctx);
+// FILTER_GAUSSIAN kernel boyutu (3, 5 veya 7)
+void setGaussianKernelSize(FilterContext *ctx, int size);
+int getGaussianKernelSize(const FilterContext *ctx);
+// Kernel filtre kalitesi (varsayılan FILTER_QUALITY_FULL)
+void setFilterQuality(FilterContext *ctx, FilterQuality quality);
+FilterQuality getFilterQuality(const FilterContext *ctx);
+// Alarm overlay'i çıkış yerine ctx->overlay ile bildirilsin (varsayılan kapalı: çıkışa boyanır)
+void setPanelOverlayEnabled(FilterContext *ctx, bool enabled);
+
+// Overlay width x height karenin tamamını kaplıyor mu: öyleyse filtre çıkışı yazmadı
+static inline bool filterOverlayCoversFrame(const FilterOverlay *overlay, int width, int height) {
+    return overlay->active && overlay->rect.x == 0 && overlay->rect.y == 0 &&
+           overlay->rect.width >= width && overlay->rect.height >= height;
+}
 
 #endif // FILTER_H
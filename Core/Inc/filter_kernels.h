@@ -0,0 +1,43 @@
+#ifndef FILTER_KERNELS_H
+#define FILTER_KERNELS_H
+
+#include <stdint.h>
+
+// Piksel çekirdekleri: her çekirdeğin saf C referansı (_ref) ve Cortex-M4 DSP/SIMD
+// sürümü (_dsp) aynı imzaya sahiptir ve bit düzeyinde aynı sonucu üretir.
+// Filtreler önek'siz isimleri kullanır; derleyici DSP destekliyorsa _dsp seçilir.
+// FILTER_KERNELS_USE_DSP 0 tanımlanırsa her zaman referans sürüm kullanılır.
+// Host testleri FILTER_KERNELS_HAVE_DSP 1 ile intrinsic'lerin taşınabilir C karşılıklarına
+// derleyip _dsp sürümlerini _ref ile karşılaştırır.
+#ifndef FILTER_KERNELS_HAVE_DSP
+#if defined(__ARM_FEATURE_DSP) && (__ARM_FEATURE_DSP == 1)
+#define FILTER_KERNELS_HAVE_DSP 1
+#else
+#define FILTER_KERNELS_HAVE_DSP 0
+#endif
+#endif
+
+#ifndef FILTER_KERNELS_USE_DSP
+#define FILTER_KERNELS_USE_DSP FILTER_KERNELS_HAVE_DSP
+#endif
+
+// RGB565 -> 8-bit gri, (r*299 + g*587 + b*114) / 1000
+void kernelLumaFromRGB565_ref(const uint16_t *src, uint8_t *dst, uint32_t count);
+
+// Mutlak kare farkı: dst[i] = |a[i] - b[i]|, dönüş değeri farkların toplamı (SAD)
+uint32_t kernelAbsDiff_ref(const uint8_t *a, const uint8_t *b, uint8_t *dst, uint32_t count);
+
+#if FILTER_KERNELS_HAVE_DSP
+void kernelLumaFromRGB565_dsp(const uint16_t *src, uint8_t *dst, uint32_t count);
+uint32_t kernelAbsDiff_dsp(const uint8_t *a, const uint8_t *b, uint8_t *dst, uint32_t count);
+#endif
+
+#if FILTER_KERNELS_USE_DSP && FILTER_KERNELS_HAVE_DSP
+#define kernelLumaFromRGB565  kernelLumaFromRGB565_dsp
+#define kernelAbsDiff         kernelAbsDiff_dsp
+#else
+#define kernelLumaFromRGB565  kernelLumaFromRGB565_ref
+#define kernelAbsDiff         kernelAbsDiff_ref
+#endif
+
+#endif // FILTER_KERNELS_H
@@ -0,0 +1,29 @@
+#ifndef FILTER_TESTS_H
+#define FILTER_TESTS_H
+
+#include <stdint.h>
+
+// Filtre ve kare hattı modüllerinin testleri.
+// Hedefte runFilterTests() main'den çağrılır ve sonuçlar debugger'dan okunur; host'ta
+// Tests/ altındaki CMake projesi aynı testleri hem _ref hem _dsp çekirdeklerle çalıştırır.
+// Her sonuç 0 (başarısız), 1 (başarılı) veya TEST_SKIPPED olur.
+#define TEST_SKIPPED 2   // Bu derlemede çalıştırılamadı (ör. DSP çekirdekleri derlenmedi)
+
+extern uint8_t grayscale_success, laplacian_success, roiopt_success, roidrift_success, roialarm_success;
+extern uint8_t kernel_equiv_success, kernel_simd_success, image_view_success, filter_context_success;
+extern uint8_t frame_pool_success, frame_mailbox_success, filter_strip_success, profiler_success;
+extern uint8_t quality_success, pipeline_command_success, boot_success, damage_success, alarm_overlay_success;
+
+// Sonuç bayrağı ve adı, host çalıştırıcısı ve listeleme için
+typedef struct {
+    const char *name;
+    const uint8_t *result;
+} FilterTestResult;
+
+extern const FilterTestResult filter_test_results[];
+extern const uint32_t filter_test_result_count;
+
+// Tüm sonuçları sıfırlar ve testleri çalıştırır. frame pool testi için framePoolInit() önceden çağrılmalı.
+void runFilterTests(void);
+
+#endif /* FILTER_TESTS_H */
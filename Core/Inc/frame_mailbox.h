@@ -0,0 +1,67 @@
+#ifndef FRAME_MAILBOX_H
+#define FRAME_MAILBOX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cmsis_os.h"
+#include "filter.h"
+#include "frame_pool.h"
+
+// Kare zaman damgaları DWT döngü sayacından (SystemCoreClock Hz), 180 MHz'de ~23 s'de bir taşar.
+// Farklar uint32_t çıkarmayla alınır, taşma sorun olmaz.
+void frameTimestampInit(void);
+
+static inline uint32_t frameTimestamp(void) {
+    return DWT->CYCCNT;
+}
+
+// Bir karenin geçtiği aşamalar
+typedef enum {
+    FRAME_STAGE_CAPTURE,   // VSYNC -> DMA tamamlandı
+    FRAME_STAGE_FILTER,
+    FRAME_STAGE_DISPLAY,   // LCD'ye yazma
+    FRAME_STAGE_COUNT
+} FrameStage;
+
+// Aşamalar arasında kareyle birlikte taşınan bilgi
+typedef struct {
+    FrameHandle frame;                       // Kare tamponu (sahipliği descriptor ile taşınır)
+    uint32_t sequence;                       // Sensör kare numarası, düşen kareler boşluk bırakır
+    uint32_t vsync_time;                     // Karenin başladığı VSYNC zamanı
+    FilterType filter_type;                  // Kareye uygulanan filtre
+    uint16_t rows_ready;                     // Üstten hazır satır sayısı, IMG_HEIGHT: kare tamam
+    uint32_t stage_enter[FRAME_STAGE_COUNT];
+    uint32_t stage_exit[FRAME_STAGE_COUNT];
+    uint32_t busy_cycles;                    // Filtrenin bu kare için harcadığı işlem süresi
+    DamageList damage;                       // damage_base karesine göre değişen bölgeler
+    uint32_t damage_base;                    // Filtrenin bir önceki çıkış karesinin sequence'i
+    FilterOverlay overlay;                   // Kareden sonra panele doğrudan çizilen dikdörtgen (alarm)
+} FrameDescriptor;
+
+// Aşamalar arası tek elemanlı posta kutusu, en yeni kare kazanır.
+// Üretici descriptor'ı bırakır (kare sahipliğini devreder), tüketici alınca sahibi olur.
+// Tüketici yetişemezse alınmamış eski kare havuza geri verilir ve dropped sayılır,
+// böylece kuyruk birikmez ve gecikme en fazla bir karedir. Aynı karenin (aynı sequence)
+// daha fazla satırı hazır olan descriptor'ı eskisinin yerini alır, bu düşme sayılmaz.
+// Post ISR içinden de çağrılabilir.
+// Descriptor posta kutusunun kendi yuvasında durur (kesmeler kapalıyken kopyalanır), ezilen
+// descriptor'ın sadece kare tutamacı okunur: görev stack'inde fazladan descriptor kopyası olmaz.
+// Tüketici ikili semaforla uyandırılır.
+typedef struct {
+    FrameDescriptor slot;
+    volatile bool full;          // slot alınmamış bir descriptor tutuyor
+    osSemaphoreId_t ready;       // Post'ta verilir, en fazla 1
+    volatile uint32_t posted;    // Bırakılan kare sayısı
+    volatile uint32_t dropped;   // Alınmadan yenisiyle değiştirilen kare sayısı
+} FrameMailbox;
+
+// Semaforu ilk çağrıda oluşturur, sonrakilerde bekleyen kareyi bırakıp boşaltır. Task içinden çağrılmalı.
+bool frameMailboxInit(FrameMailbox *mailbox, const char *name);
+
+// Descriptor'ı bırakır, kare sahipliği posta kutusuna geçer. Bekleyen eski kare bırakılır.
+void frameMailboxPost(FrameMailbox *mailbox, const FrameDescriptor *desc);
+
+// En yeni descriptor'ı alır (kare sahipliği çağırana geçer). timeout içinde kare gelmezse false.
+bool frameMailboxTake(FrameMailbox *mailbox, FrameDescriptor *desc, uint32_t timeout);
+
+#endif // FRAME_MAILBOX_H
@@ -0,0 +1,44 @@
+#ifndef FRAME_POOL_H
+#define FRAME_POOL_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "camera_drv.h"
+#include "image_view.h"
+
+// SDRAM'de sabit boyutlu kare tamponu havuzu.
+// Yakalama, filtre, ekran ve kayıt aşamaları kareleri kopyalamadan handle ile aktarır.
+// Her kare referans sayılıdır: acquire 1 ile başlatır, retain artırır, release azaltır,
+// sayaç 0'a inince kare havuza döner. Tüm fonksiyonlar task ve ISR içinden çağrılabilir.
+#define FRAME_POOL_COUNT        8
+#define FRAME_POOL_FRAME_PIXELS (IMG_WIDTH * IMG_HEIGHT)
+#define FRAME_POOL_FRAME_BYTES  (FRAME_POOL_FRAME_PIXELS * sizeof(uint16_t))
+
+typedef int8_t FrameHandle;
+#define FRAME_HANDLE_NONE       ((FrameHandle)-1)
+
+// Havuzu boşaltır. SDRAM init edildikten sonra, kareler kullanılmadan önce bir kez çağrılmalı.
+void framePoolInit(void);
+
+// Boş bir kare alır (referans sayısı 1). Havuz boşsa FRAME_HANDLE_NONE.
+FrameHandle framePoolAcquire(void);
+
+// Kullanımdaki bir kareye yeni sahip ekler. Geçersiz veya boş kare için false.
+bool framePoolRetain(FrameHandle frame);
+
+// Bir sahipliği bırakır, son sahip bırakınca kare havuza döner. Geçersiz veya boş kare için false.
+bool framePoolRelease(FrameHandle frame);
+
+// Karenin piksel belleği (RGB565, IMG_WIDTH x IMG_HEIGHT), geçersiz handle için 0
+uint16_t *framePoolData(FrameHandle frame);
+
+// Karenin tam görüntü view'ı
+ImageView framePoolView(FrameHandle frame);
+
+// Bellek adresinden handle (DMA callback'lerinde adres bilinir), havuza ait değilse FRAME_HANDLE_NONE
+FrameHandle framePoolHandleOf(const void *data);
+
+uint8_t framePoolRefCount(FrameHandle frame);
+uint8_t framePoolFreeCount(void);
+
+#endif // FRAME_POOL_H
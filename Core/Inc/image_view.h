@@ -0,0 +1,60 @@
+#ifndef IMAGE_VIEW_H
+#define IMAGE_VIEW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Piksel formatları
+typedef enum {
+    IMAGE_FORMAT_RGB565,  // 16-bit renkli
+    IMAGE_FORMAT_Y8       // 8-bit gri (luma)
+} ImageFormat;
+
+// Bir görüntü belleğine bakış: boyut, satır adımı (stride) ve format.
+// Kopya yapmadan alt pencere, küçültülmüş kare veya test görüntüsü tanımlamak için.
+typedef struct {
+    uint16_t width;     // Piksel cinsinden genişlik
+    uint16_t height;    // Satır sayısı
+    uint16_t stride;    // Bir satırdan diğerine piksel cinsinden adım (>= width)
+    ImageFormat format;
+    void *data;         // İlk pikselin adresi
+} ImageView;
+
+static inline ImageView imageViewMake(void *data, uint16_t width, uint16_t height, ImageFormat format) {
+    ImageView view = { width, height, width, format, data };
+    return view;
+}
+
+static inline uint32_t imageViewBytesPerPixel(const ImageView *view) {
+    return (view->format == IMAGE_FORMAT_RGB565) ? 2 : 1;
+}
+
+// Formattan bağımsız satır başlangıcı
+static inline void *imageViewRow(const ImageView *view, int y) {
+    return (uint8_t *)view->data + (uint32_t)y * view->stride * imageViewBytesPerPixel(view);
+}
+
+static inline uint16_t *imageViewRow16(const ImageView *view, int y) {
+    return (uint16_t *)view->data + (uint32_t)y * view->stride;
+}
+
+static inline uint8_t *imageViewRow8(const ImageView *view, int y) {
+    return (uint8_t *)view->data + (uint32_t)y * view->stride;
+}
+
+// (x, y) konumundan başlayan width x height boyutlu alt pencere, aynı belleği paylaşır
+static inline ImageView imageViewSub(const ImageView *view, int x, int y, uint16_t width, uint16_t height) {
+    ImageView sub = *view;
+    sub.data = (uint8_t *)view->data + ((uint32_t)y * view->stride + x) * imageViewBytesPerPixel(view);
+    sub.width = width;
+    sub.height = height;
+    return sub;
+}
+
+static inline bool imageViewIsValid(const ImageView *view) {
+    return view != 0 && view->data != 0 && view->width > 0 && view->height > 0 &&
+           view->stride >= view->width &&
+           (view->format == IMAGE_FORMAT_RGB565 || view->format == IMAGE_FORMAT_Y8);
+}
+
+#endif // IMAGE_VIEW_H
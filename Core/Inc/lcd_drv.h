@@ -15,14 +15,18 @@ extern "C" {
 #define LCD_DRIVER_SW_VERSION	(1.0)
 #define LCD_WIDTH	320
 #define LCD_HEIGHT	240
+#define LCD_REGION_QUEUE_DEPTH	4	// Windows waiting behind the one in flight (E_LCD_IOCTL_QUEUE_REGION_DMA)
 
 #include "stm32f4xx.h"
+#include <stdbool.h>
 
 typedef enum {
 	E_LCD_ERR_NONE,
 	E_LCD_ERR_SPI_INIT,
 	E_LCD_ERR_LCD_INIT,
-	E_LCD_ERR_WRONG_IOCTL_CMD
+	E_LCD_ERR_WRONG_IOCTL_CMD,
+	E_LCD_ERR_WRONG_REGION,
+	E_LCD_ERR_BUSY				// A DMA transfer is still running
 } te_LCD_ERROR_CODES;
 
 
@@ -34,7 +38,15 @@ typedef enum {
 	E_LCD_IOCTL_DRAW_PIXEL,
 	E_LCD_IOCTL_FILL_SCREEN,
 	E_LCD_IOCTL_DRAW_IMAGE,
-	E_LCD_IOCTL_SET_ROTATION
+	E_LCD_IOCTL_SET_ROTATION,
+	E_LCD_IOCTL_DRAW_REGION,	// ts_LCD_WR_TYPE, inclusive corners, img rows stride pixels apart
+	E_LCD_IOCTL_DRAW_REGION_DMA,	// Same, but returns once the DMA is started; img must stay valid
+								// until LCD_TransferCompleteCallback. E_LCD_ERR_BUSY if one is running.
+	E_LCD_IOCTL_QUEUE_REGION_DMA,	// Like DRAW_REGION_DMA, but queued behind a running transfer and
+								// started from its DMA interrupt. One callback per window, in order.
+								// E_LCD_ERR_BUSY if LCD_REGION_QUEUE_DEPTH windows are waiting.
+	E_LCD_IOCTL_FILL_RECT,		// ts_LCD_FILL_TYPE, one color streamed over DMA without a source buffer
+	E_LCD_IOCTL_QUEUE_FILL_RECT_DMA	// Same, queued like QUEUE_REGION_DMA and with its own callback
 } te_LCD_IOCTL_COMMANDS;
 
 typedef struct {
@@ -49,14 +61,37 @@ typedef struct {
 	uint16_t y1;
 	uint16_t y2;
 	uint16_t *img;
+	uint16_t stride;	// Pixels between the starts of two img rows, e.g. the frame width for a
+						// window inside a frame. 0: packed (x2 - x1 + 1).
 } ts_LCD_WR_TYPE;
 
+typedef struct {
+	uint16_t x1;		// Inclusive corners, as in ts_LCD_WR_TYPE
+	uint16_t x2;
+	uint16_t y1;
+	uint16_t y2;
+	uint16_t color;		// RGB565
+} ts_LCD_FILL_TYPE;
+
 te_LCD_ERROR_CODES LCD_Open(void* vpParam);
 te_LCD_ERROR_CODES LCD_Ioctl(te_LCD_IOCTL_COMMANDS eCommand, void * vpParam);
 te_LCD_ERROR_CODES LCD_Write(const void *pvBuffer, const uint32_t xBytes);
 te_LCD_ERROR_CODES LCD_Read(const void *pvBuffer, const uint32_t xBytes);
 te_LCD_ERROR_CODES LCD_Close(void *vpParam);
 
+// Waits used by LCD_Open for the panel reset and sleep-out timings, at least ms milliseconds.
+// Weak default: HAL_Delay. Override it to sleep instead, so other peripherals can be brought
+// up while the panel settles.
+void LCD_DelayMs(uint32_t ms);
+
+// Called from the SPI5 DMA interrupt when a pixel transfer has finished (or failed), once per
+// window. A queued window starts right after it returns. Weak default: nothing.
+void LCD_TransferCompleteCallback(void);
+// A window is being sent or waiting in the queue
+bool LCD_IsBusy(void);
+// SPI/DMA transfer errors since start; the failed transfer is ended and reported as complete
+uint32_t LCD_GetErrorCount(void);
+
 
 
 
@@ -0,0 +1,28 @@
+#ifndef LUMA_H
+#define LUMA_H
+
+#include <stdint.h>
+
+// RGB565 -> 8-bit gri (luma) dönüşüm tabloları.
+// Tüm filtre yolları aynı tabloyu kullanır; piksel başına bölme yapılmaz.
+#define LUMA_TABLE_SIZE 65536
+#define LUMA_LEVELS     256
+
+extern uint8_t luma_from_rgb565[LUMA_TABLE_SIZE];  // SDRAM, 64 KB
+extern uint16_t rgb565_from_luma[LUMA_LEVELS];      // SRAM, 512 B
+
+// Tabloları doldurur. SDRAM init edildikten sonra, filtreler çalışmadan önce çağrılmalı.
+void initLumaTables(void);
+
+// RGB565 görüntüyü tek geçişte 8-bit luma düzlemine çevirir
+void convertToLumaPlane(const uint16_t *image, uint8_t *plane, uint32_t pixel_count);
+
+static inline uint8_t lumaFromRGB565(uint16_t rgb) {
+    return luma_from_rgb565[rgb];
+}
+
+static inline uint16_t rgb565FromLuma(uint8_t gray) {
+    return rgb565_from_luma[gray];
+}
+
+#endif // LUMA_H
@@ -0,0 +1,53 @@
+#ifndef PIPELINE_COMMAND_H
+#define PIPELINE_COMMAND_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cmsis_os.h"
+#include "filter.h"
+
+// Boru hattı ayarları (filtre tipi, Gaussian boyutu, ROI optimizasyonu) sadece komutlarla değişir.
+// Buton ISR'si ve diğer kaynaklar komutu kuyruğa bırakır; FilterTask bekleyen tüm komutları
+// iki kare arasında tek seferde uygular, böylece bir kare hiçbir zaman yarı eski yarı yeni
+// ayarla işlenmez.
+#define PIPELINE_COMMAND_QUEUE_LENGTH 8
+
+typedef enum {
+    PIPELINE_CMD_CYCLE_FILTER,          // Sıradaki filtre (buton)
+    PIPELINE_CMD_SET_FILTER,            // value: FilterType
+    PIPELINE_CMD_SET_GAUSSIAN_SIZE,     // value: 3, 5 veya 7
+    PIPELINE_CMD_SET_ROI_OPTIMIZATION   // value: 0 kapalı, 1 açık
+} PipelineCommandType;
+
+typedef struct {
+    PipelineCommandType type;
+    int32_t value;
+} PipelineCommand;
+
+typedef struct {
+    FilterType filter_type;
+    int gaussian_size;
+    bool roi_optimization;
+} PipelineConfig;
+
+typedef struct {
+    osMessageQueueId_t queue;
+    volatile uint32_t posted;    // Kuyruğa giren komut sayısı
+    volatile uint32_t dropped;   // Kuyruk dolu olduğu için kaybolan komut sayısı
+    uint32_t applied;            // Uygulanan komut sayısı (geçersizler hariç)
+} PipelineCommandQueue;
+
+// Kuyruğu ilk çağrıda oluşturur, sonrakilerde bekleyen komutları siler. Task içinden çağrılmalı.
+bool pipelineCommandInit(PipelineCommandQueue *commands, const char *name);
+
+// Komutu kuyruğa bırakır, beklemez. ISR içinden de çağrılabilir. Kuyruk doluysa false.
+bool pipelineCommandPost(PipelineCommandQueue *commands, PipelineCommandType type, int32_t value);
+
+// Bekleyen tüm komutları sırayla config'e uygular. Geçersiz değerler yok sayılır.
+// Config değiştiyse true.
+bool pipelineCommandApply(PipelineCommandQueue *commands, PipelineConfig *config);
+
+// Buton sırası: NONE -> GRAYSCALE -> LAPLACIAN -> GAUSSIAN -> ROI -> ROI_CENTER_ALARM -> NONE
+FilterType pipelineNextFilter(FilterType filter_type);
+
+#endif // PIPELINE_COMMAND_H
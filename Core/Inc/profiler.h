@@ -0,0 +1,81 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+#include "stm32f4xx.h"
+#include "filter.h"
+
+// DWT döngü sayacı ile aşama süresi ölçümü: her prob için min/max/ortalama, log2 histogram
+// ve son örneklerin halkası. Durum profiler_state'te, debugger'dan okunabilir veya
+// profilerDump ile metin olarak dökülebilir. PROFILER_ENABLED 0 iken tüm PROFILE_* makroları
+// boşa açılır, argümanları bile hesaplanmaz.
+#ifndef PROFILER_ENABLED
+#define PROFILER_ENABLED 1
+#endif
+
+#define PROFILER_HIST_BUCKETS 32    // Kova k: [2^(k-1), 2^k) döngü, kova 0: 0 döngü
+#define PROFILER_RING_SIZE    128   // Son örnekler (2'nin kuvveti)
+
+typedef enum {
+    PROFILE_PROBE_CAPTURE,                                       // VSYNC -> DMA kare tamamlandı
+    PROFILE_PROBE_FILTER,                                        // + FilterType, karenin filtre hesap süresi
+    PROFILE_PROBE_LCD = PROFILE_PROBE_FILTER + FILTER_TYPE_COUNT, // Tek LCD yazma çağrısı
+    PROFILE_PROBE_GLASS,                                         // VSYNC -> karenin son satırı LCD'de
+    PROFILE_PROBE_COUNT
+} ProfileProbe;
+
+typedef struct {
+    uint32_t count;
+    uint32_t min;
+    uint32_t max;
+    uint64_t sum;
+    uint32_t histogram[PROFILER_HIST_BUCKETS];
+} ProfileStats;
+
+typedef struct {
+    uint32_t timestamp;     // Kayıt anı (DWT)
+    uint32_t cycles;
+    uint8_t probe;
+} ProfileSample;
+
+typedef struct {
+    ProfileStats stats[PROFILE_PROBE_COUNT];
+    ProfileSample ring[PROFILER_RING_SIZE];
+    uint32_t ring_head;     // Toplam kayıt sayısı, sıradaki yuva ring_head % PROFILER_RING_SIZE
+} ProfilerState;
+
+extern ProfilerState profiler_state;
+
+typedef void (*ProfilerWriteFn)(const char *text);
+
+static inline uint32_t profilerNow(void) {
+    return DWT->CYCCNT;
+}
+
+// DWT sayacını açar (sıfırlamaz) ve istatistikleri siler
+void profilerInit(void);
+void profilerReset(void);
+// Task ve ISR içinden çağrılabilir
+void profilerRecord(ProfileProbe probe, uint32_t cycles);
+uint32_t profilerMean(const ProfileStats *stats);
+const char *profilerProbeName(ProfileProbe probe);
+// Örneği olan probların özetini ve histogramını satır satır yazar
+void profilerDump(ProfilerWriteFn write);
+
+#if PROFILER_ENABLED
+#define PROFILE_VAR(name)               uint32_t name = 0
+#define PROFILE_START(name)             ((name) = profilerNow())
+#define PROFILE_STOP(probe, name)       profilerRecord((probe), profilerNow() - (name))
+#define PROFILE_ADD(total, name)        ((total) += profilerNow() - (name))
+#define PROFILE_CLEAR(total)            ((total) = 0)
+#define PROFILE_RECORD(probe, cycles)   profilerRecord((probe), (cycles))
+#else
+#define PROFILE_VAR(name)               ((void)0)
+#define PROFILE_START(name)             ((void)0)
+#define PROFILE_STOP(probe, name)       ((void)0)
+#define PROFILE_ADD(total, name)        ((void)0)
+#define PROFILE_CLEAR(total)            ((void)0)
+#define PROFILE_RECORD(probe, cycles)   ((void)0)
+#endif
+
+#endif // PROFILER_H
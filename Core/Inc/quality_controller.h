@@ -0,0 +1,63 @@
+#ifndef QUALITY_CONTROLLER_H
+#define QUALITY_CONTROLLER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "filter.h"
+
+// Kare süresi bütçesini tutan uyarlamalı kalite kontrolü.
+// Her gösterilen karenin işlem süresi (filtre + LCD, DWT döngüsü) sensör karesi başına
+// düşen süreye çevrilip bütçeyle karşılaştırılır. Üst üste QUALITY_DEGRADE_FRAMES kare bütçeyi
+// aşarsa bir seviye düşülür; QUALITY_RECOVER_FRAMES kare boyunca bütçenin
+// QUALITY_RECOVER_PERCENT'inin altında kalırsa bir seviye geri çıkılır. Seviyeler birikimlidir.
+#define QUALITY_DEGRADE_FRAMES   3
+#define QUALITY_RECOVER_FRAMES   30
+#define QUALITY_RECOVER_PERCENT  45
+
+typedef enum {
+    QUALITY_LEVEL_FULL,
+    QUALITY_LEVEL_HALF_ROWS,        // Kernel her 2 satırdan birinde
+    QUALITY_LEVEL_HALF_RES,         // Kernel yarım çözünürlüklü luma düzleminde
+    QUALITY_LEVEL_SKIP_ALTERNATE,   // + tek sıra numaralı kareler işlenmez ve gösterilmez
+    QUALITY_LEVEL_HALF_CAPTURE,     // + DCMI her 2 sensör karesinden birini yakalar
+    QUALITY_LEVEL_COUNT
+} QualityLevel;
+
+typedef struct {
+    uint32_t budget_cycles;         // Sensör karesi başına bütçe, çalışırken değiştirilebilir
+    volatile QualityLevel level;    // Tek yazan kontrol, diğer görevler sadece okur
+    FilterType filter_type;         // Filtre değişince tam kaliteden yeniden başlanır
+    uint8_t over_count;             // Üst üste bütçeyi aşan kare
+    uint16_t under_count;           // Üst üste geri çıkma eşiğinin altında kalan kare
+    uint32_t last_cost;             // Son karenin sensör karesi başına süresi
+    uint32_t level_changes;
+} QualityController;
+
+void qualityControllerInit(QualityController *qc, uint32_t budget_cycles);
+void qualityControllerReset(QualityController *qc);
+// Gösterilen bir karenin toplam işlem süresiyle seviyeyi günceller, seviye değiştiyse true
+bool qualityControllerUpdate(QualityController *qc, FilterType filter_type, uint32_t busy_cycles);
+
+// İşlenen her karenin karşılığı olan sensör karesi sayısı
+static inline uint32_t qualityFrameDivisor(QualityLevel level) {
+    if (level >= QUALITY_LEVEL_HALF_CAPTURE) return 4;
+    if (level >= QUALITY_LEVEL_SKIP_ALTERNATE) return 2;
+    return 1;
+}
+
+static inline FilterQuality qualityFilterQuality(QualityLevel level) {
+    if (level >= QUALITY_LEVEL_HALF_RES) return FILTER_QUALITY_HALF_RES;
+    if (level == QUALITY_LEVEL_HALF_ROWS) return FILTER_QUALITY_HALF_ROWS;
+    return FILTER_QUALITY_FULL;
+}
+
+// Bu seviyede sequence numaralı kare atlanır mı
+static inline bool qualitySkipsFrame(QualityLevel level, uint32_t sequence) {
+    return level >= QUALITY_LEVEL_SKIP_ALTERNATE && (sequence & 1);
+}
+
+static inline bool qualityHalvesCapture(QualityLevel level) {
+    return level >= QUALITY_LEVEL_HALF_CAPTURE;
+}
+
+#endif // QUALITY_CONTROLLER_H
@@ -57,6 +57,7 @@ void DMA2_Stream1_IRQHandler(void);
 void DCMI_IRQHandler(void);
 void EXTI0_IRQHandler(void);
 /* USER CODE BEGIN EFP */
+void DMA2_Stream4_IRQHandler(void);
 
 /* USER CODE END EFP */
 
@@ -0,0 +1,46 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "cmsis_os.h"
+
+// Görev başına CPU yükü ve stack high-water izleme.
+// FreeRTOS run-time sayacı DWT döngü sayacıdır (configGENERATE_RUN_TIME_STATS), periyodik bir
+// osTimer her TELEMETRY_PERIOD_MS'de görevleri örnekler. Sonuçlar telemetry_state'te sayaç
+// olarak durur, debugger'dan okunur; stack ve öncelikler bu değerlere göre boyutlandırılır.
+#define TELEMETRY_PERIOD_MS  1000   // DWT 180 MHz'de ~23 s'de taşar, periyot bundan kısa olmalı
+#define TELEMETRY_MAX_TASKS  8
+
+typedef struct {
+    char name[configMAX_TASK_NAME_LEN];
+    uint32_t task_number;        // FreeRTOS'un göreve verdiği tekil numara
+    bool alive;                  // Son örnekte görev hâlâ vardı (silinen görevin son değerleri kalır)
+    uint16_t cpu_permille;       // Son periyotta CPU payı (binde)
+    uint16_t cpu_permille_max;
+    uint32_t stack_free_min;     // Görev başladığından beri en az boş stack (byte)
+    uint32_t run_time;           // Önceki örnekteki run-time sayacı
+} TelemetryTask;
+
+typedef struct {
+    TelemetryTask tasks[TELEMETRY_MAX_TASKS];
+    uint8_t task_count;
+    uint32_t samples;
+    uint16_t cpu_load_permille;  // 1000 - IDLE payı
+    uint16_t cpu_load_permille_max;
+    uint32_t heap_free_min;      // Heap'in açılıştan beri en düşük boş alanı (byte)
+    uint32_t total_run_time;     // Önceki örnekteki toplam run-time
+} TelemetryState;
+
+extern TelemetryState telemetry_state;
+
+// Örnekleme zamanlayıcısını kurar, kernel başlatılmadan (RTOS_TIMERS) çağrılır
+bool telemetryInit(void);
+// Bir örnek alır; zamanlayıcı çağırır, testte elle de çağrılabilir
+void telemetrySample(void);
+
+// FreeRTOSConfig.h: portCONFIGURE_TIMER_FOR_RUN_TIME_STATS / portGET_RUN_TIME_COUNTER_VALUE
+void configureTimerForRunTimeStats(void);
+unsigned long getRunTimeCounterValue(void);
+
+#endif // TELEMETRY_H
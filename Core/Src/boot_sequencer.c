@@ -0,0 +1,47 @@
+#include "boot_sequencer.h"
+#include "stm32f4xx_hal.h"
+#include "frame_mailbox.h"
+#include "cmsis_os.h"
+
+void bootProfileBegin(BootProfile *boot) {
+    boot->start_tick = HAL_GetTick();
+    boot->origin = frameTimestamp();
+    for (int i = 0; i < BOOT_STAGE_COUNT; i++) {
+        boot->stage_start[i] = 0;
+        boot->stage_end[i] = 0;
+        boot->stage_done[i] = false;
+    }
+}
+
+void bootStageBegin(BootProfile *boot, BootStage stage) {
+    boot->stage_start[stage] = frameTimestamp() - boot->origin;
+}
+
+void bootStageEnd(BootProfile *boot, BootStage stage) {
+    if (boot->stage_done[stage]) return;
+    boot->stage_end[stage] = frameTimestamp() - boot->origin;
+    boot->stage_done[stage] = true;
+}
+
+bool bootStageDone(const BootProfile *boot, BootStage stage) {
+    return boot->stage_done[stage];
+}
+
+uint32_t bootStageCycles(const BootProfile *boot, BootStage stage) {
+    if (!boot->stage_done[stage]) return 0;
+    return boot->stage_end[stage] - boot->stage_start[stage];
+}
+
+uint32_t bootStageReadyMs(const BootProfile *boot, BootStage stage) {
+    if (!boot->stage_done[stage]) return 0;
+    return boot->start_tick + boot->stage_end[stage] / (SystemCoreClock / 1000);
+}
+
+void bootDelayMs(uint32_t ms) {
+    if (osKernelGetState() == osKernelRunning) {
+        // osDelay mevcut tick'in kalanını da sayar, en az ms için bir tick fazlası
+        osDelay(ms / portTICK_PERIOD_MS + 1);
+    } else {
+        HAL_Delay(ms);
+    }
+}
@@ -30,16 +30,29 @@ extern I2C_HandleTypeDef hi2c1;
 extern DCMI_HandleTypeDef hdcmi;
 
 static te_CAMERA_ERROR_CODES Camera_Init(void);
-void Camera_Delay (volatile uint16_t nCount);
 bool Camera_Write(uint8_t reg_addr, uint8_t* data);
 static void Camera_GPIO_Init(void);
 static te_CAMERA_ERROR_CODES Camera_DCMI_Init(void);
 static void Camera_XCLK_Init();
 static te_CAMERA_ERROR_CODES Camera_DMA_Init(void);
 static te_CAMERA_ERROR_CODES Camera_I2C_Init(void);
+static void Camera_DMA_M0Complete(DMA_HandleTypeDef *hdma);
+static void Camera_DMA_M1Complete(DMA_HandleTypeDef *hdma);
+static void Camera_DMA_Error(DMA_HandleTypeDef *hdma);
+static void Camera_Restart(void);
 
 extern DMA_HandleTypeDef hdma_dcmi;
 
+// Buffers currently programmed into M0AR / M1AR
+static uint16_t * volatile capture_buffer[2];
+static volatile uint32_t capture_error_count;
+// DWT time of the latest and the previous VSYNC, lines received since the latest
+static volatile uint32_t capture_vsync_time[2];
+static volatile uint16_t capture_lines_since_vsync;
+// Frame capture rate control field of DCMI_CR, and the value to apply at the next VSYNC
+#define CAMERA_DCMI_CR_FCRC		(DCMI_CR_FCRC_0 | DCMI_CR_FCRC_1)
+static volatile uint32_t capture_rate_request = DCMI_CR_ALL_FRAME;
+
 const uint8_t OV7670_reg [OV7670_REG_NUM][2] = {
 	{0x12, 0x80},		//Reset registers
 
@@ -140,26 +153,23 @@ te_CAMERA_ERROR_CODES Camera_Open(void) {
 	return E_CAMERA_ERR_NONE;
 }
 
-void Camera_Delay (volatile uint16_t nCount){
-  while(nCount--){
-  }
+__weak void Camera_DelayMs(uint32_t ms) {
+	HAL_Delay(ms);
 }
 
 static te_CAMERA_ERROR_CODES Camera_Init(void) {
 	uint8_t data, i = 0;
 	bool err;
-	uint16_t color = PURPLE;
-	uint8_t rotation = SCREEN_HORIZONTAL_2;
-	LCD_Ioctl(E_LCD_IOCTL_FILL_SCREEN, &color);
-	LCD_Ioctl(E_LCD_IOCTL_SET_ROTATION, &rotation);
-	// Configure camera registers
+	// Configure camera registers. The LCD is brought up separately, in parallel.
 	for(i=0; i<OV7670_REG_NUM ;i++){
 		data = OV7670_reg[i][1];
 		err = Camera_Write(OV7670_reg[i][0], &data);
 
 		if (err == true)
 			return E_CAMERA_ERR_CAMERA_INIT;
-		Camera_Delay(0xFFFF);
+		// Only the COM7 register reset needs settling time, other writes take effect at once
+		if (OV7670_reg[i][0] == OV7670_COM7 && (data & OV7670_COM7_RESET))
+			Camera_DelayMs(OV7670_RESET_WAIT_MS);
 	}
 
 	return E_CAMERA_ERR_NONE;
@@ -278,7 +288,8 @@ static te_CAMERA_ERROR_CODES Camera_DMA_Init(void) {
 	}
 
 	// DMA interrupt'ı enable et
-	HAL_NVIC_SetPriority(DMA2_Stream1_IRQn, 0, 0);
+	// Frame-complete callback uses RTOS calls: keep at or below configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	HAL_NVIC_SetPriority(DMA2_Stream1_IRQn, 5, 0);
 	HAL_NVIC_EnableIRQ(DMA2_Stream1_IRQn);
 
 	return E_CAMERA_ERR_NONE;
@@ -316,4 +327,122 @@ static te_CAMERA_ERROR_CODES Camera_I2C_Init(void) {
 	return E_CAMERA_ERR_NONE;
 }
 
+te_CAMERA_ERROR_CODES Camera_StartCapture(uint16_t *buffer0, uint16_t *buffer1) {
+	capture_buffer[0] = buffer0;
+	capture_buffer[1] = buffer1;
+
+	hdcmi.State = HAL_DCMI_STATE_BUSY;
+	__HAL_DCMI_ENABLE(&hdcmi);
+	hdcmi.Instance->CR &= ~(DCMI_CR_CM);
+	hdcmi.Instance->CR |= DCMI_MODE_CONTINUOUS;
+
+	// One transfer is exactly one frame, so every transfer-complete marks a finished frame
+	hdma_dcmi.XferCpltCallback = Camera_DMA_M0Complete;
+	hdma_dcmi.XferM1CpltCallback = Camera_DMA_M1Complete;
+	hdma_dcmi.XferErrorCallback = Camera_DMA_Error;
+	hdma_dcmi.XferAbortCallback = NULL;
+
+	if (HAL_DMAEx_MultiBufferStart_IT(&hdma_dcmi, (uint32_t)&hdcmi.Instance->DR,
+			(uint32_t)buffer0, (uint32_t)buffer1, CAMERA_FRAME_WORDS) != HAL_OK) {
+		return E_CAMERA_ERR_DMA_INIT;
+	}
+
+	hdcmi.Instance->CR |= DCMI_CR_CAPTURE;
+	return E_CAMERA_ERR_NONE;
+}
+
+uint32_t Camera_GetErrorCount(void) {
+	return capture_error_count;
+}
+
+void Camera_SetCaptureRate(uint32_t capture_rate) {
+	if (capture_rate == DCMI_CR_ALL_FRAME || capture_rate == DCMI_CR_ALTERNATE_2_FRAME ||
+			capture_rate == DCMI_CR_ALTERNATE_4_FRAME) {
+		capture_rate_request = capture_rate;
+	}
+}
+
+__weak uint16_t *Camera_FrameCompleteCallback(uint16_t *frame, uint32_t vsync_time) {
+	return frame;
+}
+
+// VSYNC interrupt fires when vertical blanking starts, i.e. just before a frame's first line
+void HAL_DCMI_VsyncEventCallback(DCMI_HandleTypeDef *phdcmi) {
+	capture_vsync_time[1] = capture_vsync_time[0];
+	capture_vsync_time[0] = DWT->CYCCNT;
+	capture_lines_since_vsync = 0;
+
+	// Frame rate changes take effect in vertical blanking, never in the middle of a frame
+	if ((phdcmi->Instance->CR & CAMERA_DCMI_CR_FCRC) != capture_rate_request) {
+		MODIFY_REG(phdcmi->Instance->CR, CAMERA_DCMI_CR_FCRC, capture_rate_request);
+		phdcmi->Init.CaptureRate = capture_rate_request;
+	}
+}
+
+__weak void Camera_StripCompleteCallback(uint16_t *frame, uint16_t rows_ready, uint32_t vsync_time) {
+}
+
+__weak void Camera_CaptureRestartCallback(void) {
+}
+
+// The line interrupt fires when a line ends, but its last pixels can still sit in the DCMI and
+// DMA FIFOs. A line is reported only once the next one has ended.
+void HAL_DCMI_LineEventCallback(DCMI_HandleTypeDef *phdcmi) {
+	uint16_t lines = ++capture_lines_since_vsync;
+	uint16_t rows_ready = lines - 1;
+
+	if (rows_ready > 0 && rows_ready < IMG_HEIGHT && rows_ready % CAMERA_STRIP_ROWS == 0) {
+		// CT selects the buffer the DMA is filling now
+		uint32_t slot = (hdma_dcmi.Instance->CR & DMA_SxCR_CT) ? 1 : 0;
+		Camera_StripCompleteCallback(capture_buffer[slot], rows_ready, capture_vsync_time[0]);
+	}
+}
+
+// The DMA completes after the last line, close to the next frame's VSYNC. If that VSYNC
+// has already been seen, the completed frame started at the one before it.
+static uint32_t Camera_FrameVsyncTime(void) {
+	return (capture_lines_since_vsync < IMG_HEIGHT / 2) ? capture_vsync_time[1] : capture_vsync_time[0];
+}
+
+// The completed slot is idle until the DMA switches back to it, so it can be reprogrammed here
+static void Camera_FrameComplete(uint32_t slot) {
+	uint16_t *frame = capture_buffer[slot];
+	uint16_t *next = Camera_FrameCompleteCallback(frame, Camera_FrameVsyncTime());
+
+	if (next != frame) {
+		HAL_DMAEx_ChangeMemory(&hdma_dcmi, (uint32_t)next, (slot == 0) ? MEMORY0 : MEMORY1);
+		capture_buffer[slot] = next;
+	}
+}
+
+static void Camera_DMA_M0Complete(DMA_HandleTypeDef *hdma) {
+	Camera_FrameComplete(0);
+}
+
+static void Camera_DMA_M1Complete(DMA_HandleTypeDef *hdma) {
+	Camera_FrameComplete(1);
+}
 
+static void Camera_DMA_Error(DMA_HandleTypeDef *hdma) {
+	capture_error_count++;
+	// FIFO errors leave the stream running; transfer errors stop it
+	if (hdma->State == HAL_DMA_STATE_READY) {
+		Camera_Restart();
+	}
+}
+
+// DCMI sync/overflow: HAL aborts the DMA and reports here once the stream is stopped
+void HAL_DCMI_ErrorCallback(DCMI_HandleTypeDef *phdcmi) {
+	capture_error_count++;
+	Camera_Restart();
+}
+
+// Restart on the same buffers; toggling DCMIEN resynchronises on the next frame start.
+// The partial frame is abandoned before the first line of the new one can be reported.
+static void Camera_Restart(void) {
+	__HAL_DCMI_DISABLE(&hdcmi);
+	hdcmi.ErrorCode = HAL_DCMI_ERROR_NONE;
+	capture_lines_since_vsync = 0;
+	Camera_CaptureRestartCallback();
+	Camera_StartCapture(capture_buffer[0], capture_buffer[1]);
+}
@@ -0,0 +1,95 @@
+#include "damage.h"
+
+static inline uint32_t rectArea(const DamageRect *rect) {
+    return (uint32_t)rect->width * rect->height;
+}
+
+// Kesişen veya kenarları değen dikdörtgenler
+static bool rectsTouch(const DamageRect *a, const DamageRect *b) {
+    return a->x <= b->x + b->width && b->x <= a->x + a->width &&
+           a->y <= b->y + b->height && b->y <= a->y + a->height;
+}
+
+// İkisini kapsayan en küçük dikdörtgen
+static DamageRect rectUnion(const DamageRect *a, const DamageRect *b) {
+    int x0 = a->x < b->x ? a->x : b->x;
+    int y0 = a->y < b->y ? a->y : b->y;
+    int x1 = a->x + a->width > b->x + b->width ? a->x + a->width : b->x + b->width;
+    int y1 = a->y + a->height > b->y + b->height ? a->y + a->height : b->y + b->height;
+    DamageRect rect = { x0, y0, x1 - x0, y1 - y0 };
+    return rect;
+}
+
+static void removeRect(DamageList *damage, int index) {
+    damage->rects[index] = damage->rects[--damage->count];
+}
+
+void damageClear(DamageList *damage, uint16_t width, uint16_t height) {
+    damage->count = 0;
+    damage->full = false;
+    damage->width = width;
+    damage->height = height;
+}
+
+void damageSetFull(DamageList *damage, uint16_t width, uint16_t height) {
+    damageClear(damage, width, height);
+    damage->full = true;
+}
+
+void damageAdd(DamageList *damage, int x, int y, int width, int height) {
+    int x1 = x + width;
+    int y1 = y + height;
+
+    if (damage->full) return;
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x1 > damage->width) x1 = damage->width;
+    if (y1 > damage->height) y1 = damage->height;
+    if (x >= x1 || y >= y1) return;
+
+    DamageRect rect = { x, y, x1 - x, y1 - y };
+
+    for (;;) {
+        // Değen dikdörtgenler yenisine katılır. Büyüyen dikdörtgen başkalarına değebilir,
+        // bu yüzden her birleşmeden sonra baştan bakılır.
+        for (int i = 0; i < damage->count; i++) {
+            if (rectsTouch(&rect, &damage->rects[i])) {
+                rect = rectUnion(&rect, &damage->rects[i]);
+                removeRect(damage, i);
+                i = -1;
+            }
+        }
+        if (damage->count < DAMAGE_MAX_RECTS) break;
+
+        // Liste dolu: alanı en az büyüten dikdörtgenle birleşir
+        int best = 0;
+        uint32_t best_growth = UINT32_MAX;
+        for (int i = 0; i < damage->count; i++) {
+            DamageRect merged = rectUnion(&rect, &damage->rects[i]);
+            uint32_t growth = rectArea(&merged) - rectArea(&rect) - rectArea(&damage->rects[i]);
+            if (growth < best_growth) {
+                best_growth = growth;
+                best = i;
+            }
+        }
+        rect = rectUnion(&rect, &damage->rects[best]);
+        removeRect(damage, best);
+    }
+
+    damage->rects[damage->count++] = rect;
+
+    if (damageArea(damage) * 100 >= (uint32_t)damage->width * damage->height * DAMAGE_FULL_PERCENT) {
+        damage->full = true;
+    }
+}
+
+uint32_t damageArea(const DamageList *damage) {
+    uint32_t area = 0;
+
+    if (damage->full) return (uint32_t)damage->width * damage->height;
+    // Dikdörtgenler birbirine değmez, alanlar toplanabilir
+    for (int i = 0; i < damage->count; i++) {
+        area += rectArea(&damage->rects[i]);
+    }
+    return area;
+}
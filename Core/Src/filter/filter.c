@@ -1,10 +1,10 @@
 #include "filter.h"
+#include "luma.h"
+#include "filter_kernels.h"
 #include "camera_drv.h"
 #include "cmsis_os.h"  // FreeRTOS için gerekli
-
-// SDRAM adresi (main.c'den alındı)
-#define SDRAM_BANK_ADDR     ((uint32_t)0xD0000000)
-#define PREVIOUS_FRAME_ADDR (SDRAM_BANK_ADDR + 0x100000) // SDRAM'de önceki kare için ayrılan alan
+#include <string.h>
+#include <stdlib.h>
 
 const int laplacian_kernel[3][3] = {
     {-1, -1, -1},
@@ -19,43 +19,158 @@ const int gaussian_kernel[3][3] = {
 const int gaussian_factor = 16;
 
 
-static bool roi_optimization_enabled = false;  // ROI optimizasyon flag'i
+// Context'i luma geçmiş halkasıyla hazırla, ayarları varsayılana döndür.
+// luma_planes art arda plane_count adet plane_size byte'lık düzlemdir (en fazla FILTER_HISTORY_DEPTH).
+// Her düzlem width*height byte olmalı; daha küçük düzlemler sadece daha küçük görüntülerle çalışır.
+// Önceki kareyi kullanan filtreler için en az 2 düzlem gerekir.
+void filterContextInit(FilterContext *ctx, uint8_t *luma_planes, uint32_t plane_size, uint8_t plane_count) {
+    if (luma_planes == 0) plane_count = 0;
+    if (plane_count > FILTER_HISTORY_DEPTH) plane_count = FILTER_HISTORY_DEPTH;
+
+    ctx->gaussian_size = 3;
+    ctx->roi_optimization = false;
+    ctx->quality = FILTER_QUALITY_FULL;
+    ctx->panel_overlay = false;
+    for (int i = 0; i < plane_count; i++) {
+        ctx->luma_ring[i] = luma_planes + (uint32_t)i * plane_size;
+    }
+    ctx->luma_ring_plane_size = plane_size;
+    ctx->luma_ring_depth = plane_count;
+    ctx->luma_ring_head = 0;
+    filterContextReset(ctx);
+}
+
+// Geçmiş kareyi ve alarm durumunu sil, ayarlar ve tamponlar korunur
+void filterContextReset(FilterContext *ctx) {
+    ctx->luma_ring_frames = 0;
+    ctx->last_filter = FILTER_NONE;
+    ctx->alarm_active = false;
+    ctx->alarm_start_time = 0;
+    ctx->has_output = false;
+    ctx->changed_blocks = 0;
+    ctx->strip_active = false;
+    ctx->strip_rows_out = 0;
+}
 
 // ROI optimizasyon kontrol fonksiyonları
-void setROIOptimizationEnabled(bool enabled) {
-    roi_optimization_enabled = enabled;
+void setROIOptimizationEnabled(FilterContext *ctx, bool enabled) {
+    ctx->roi_optimization = enabled;
+}
+
+bool isROIOptimizationEnabled(const FilterContext *ctx) {
+    return ctx->roi_optimization;
+}
+
+// Gaussian kernel boyutu ayarı, geçersiz değerler yok sayılır
+void setGaussianKernelSize(FilterContext *ctx, int size) {
+    if (size == 3 || size == 5 || size == 7) {
+        if (size != ctx->gaussian_size) ctx->has_output = false;  // Önceki çıkış artık yeniden kullanılamaz
+        ctx->gaussian_size = size;
+    }
+}
+
+int getGaussianKernelSize(const FilterContext *ctx) {
+    return ctx->gaussian_size;
+}
+
+void setFilterQuality(FilterContext *ctx, FilterQuality quality) {
+    if (quality != ctx->quality) ctx->has_output = false;  // Önceki çıkış başka kalitede
+    ctx->quality = quality;
+}
+
+FilterQuality getFilterQuality(const FilterContext *ctx) {
+    return ctx->quality;
 }
 
-bool isROIOptimizationEnabled(void) {
-    return roi_optimization_enabled;
+void setPanelOverlayEnabled(FilterContext *ctx, bool enabled) {
+    ctx->panel_overlay = enabled;
+}
+
+// Alarm dikdörtgenini görüntüye kırpıp overlay olarak bildirir
+static void setAlarmOverlay(FilterContext *ctx, int x, int y, int size_x, int size_y, int width, int height) {
+    int x1 = x + size_x;
+    int y1 = y + size_y;
+
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x1 > width) x1 = width;
+    if (y1 > height) y1 = height;
+    ctx->overlay.active = x < x1 && y < y1;
+    ctx->overlay.rect.x = x;
+    ctx->overlay.rect.y = y;
+    ctx->overlay.rect.width = x1 - x;
+    ctx->overlay.rect.height = y1 - y;
+    ctx->overlay.color = ALARM_COLOR;
+}
+
+// (x, y) pikselinin gri değeri, RGB565 veya Y8 görüntüden
+static inline uint8_t lumaAt(const ImageView *view, int x, int y) {
+    if (view->format == IMAGE_FORMAT_Y8) {
+        return imageViewRow8(view, y)[x];
+    }
+    return lumaFromRGB565(imageViewRow16(view, y)[x]);
+}
+
+// (x, y) pikselinin RGB565 değeri, Y8 görüntüler gri olarak genişletilir
+static inline uint16_t rgb565At(const ImageView *view, int x, int y) {
+    if (view->format == IMAGE_FORMAT_Y8) {
+        return rgb565FromLuma(imageViewRow8(view, y)[x]);
+    }
+    return imageViewRow16(view, y)[x];
+}
+
+// Giriş görüntüsünü RGB565 çıkışa satır satır kopyala
+static void copyImage(const ImageView *input, const ImageView *output) {
+    for (int y = 0; y < input->height; y++) {
+        uint16_t *out = imageViewRow16(output, y);
+        if (input->format == IMAGE_FORMAT_RGB565) {
+            memcpy(out, imageViewRow16(input, y), input->width * sizeof(uint16_t));
+        } else {
+            const uint8_t *in = imageViewRow8(input, y);
+            for (int x = 0; x < input->width; x++) {
+                out[x] = rgb565FromLuma(in[x]);
+            }
+        }
+    }
+}
+
+// Filtre girişi/çıkışı geçerli mi: çıkış RGB565 olmalı, boyutlar aynı olmalı
+static bool isFilterIOValid(const ImageView *input, const ImageView *output) {
+    return imageViewIsValid(input) && imageViewIsValid(output) &&
+           output->format == IMAGE_FORMAT_RGB565 &&
+           input->width == output->width && input->height == output->height;
 }
 
 // Bir ROI bloğunda değişim olup olmadığını kontrol et
-static bool checkROIBlockChange(uint16_t *current_frame, uint16_t *previous_frame, 
+static bool checkROIBlockChange(const ImageView *current_frame, const ImageView *previous_frame,
                               int start_x, int start_y, int block_size) {
-    int total_change = 0;
-    
-    for (int y = start_y; y < start_y + block_size && y < IMG_ROWS; y++) {
-        for (int x = start_x; x < start_x + block_size && x < IMG_COLUMNS; x++) {
-            if (y >= 0 && x >= 0) {
-                uint16_t current_rgb = current_frame[y * IMG_COLUMNS + x];
-                uint16_t previous_rgb = previous_frame[y * IMG_COLUMNS + x];
-                
-                // RGB565'den grayscale'e dönüştür
-                uint8_t current_gray = ((current_rgb >> 11) & 0x1F) * 299/1000 + 
-                                     ((current_rgb >> 5) & 0x3F) * 587/1000 + 
-                                     (current_rgb & 0x1F) * 114/1000;
-                
-                uint8_t previous_gray = ((previous_rgb >> 11) & 0x1F) * 299/1000 + 
-                                      ((previous_rgb >> 5) & 0x3F) * 587/1000 + 
-                                      (previous_rgb & 0x1F) * 114/1000;
-                
-                total_change += abs(current_gray - previous_gray);
-            }
+    uint32_t total_change = 0;
+    uint8_t diff_row[ROI_OPT_BLOCK_SIZE];
+    int end_x = (start_x + block_size < current_frame->width) ? start_x + block_size : current_frame->width;
+    int end_y = (start_y + block_size < current_frame->height) ? start_y + block_size : current_frame->height;
+
+    if (start_x < 0) start_x = 0;
+    if (start_y < 0) start_y = 0;
+
+    for (int y = start_y; y < end_y; y++) {
+        if (current_frame->format == IMAGE_FORMAT_Y8 && previous_frame->format == IMAGE_FORMAT_Y8 &&
+            end_x - start_x <= ROI_OPT_BLOCK_SIZE) {
+            // İki luma düzlemi: satır farkı SIMD çekirdeği ile
+            total_change += kernelAbsDiff(&imageViewRow8(current_frame, y)[start_x],
+                                          &imageViewRow8(previous_frame, y)[start_x],
+                                          diff_row, end_x - start_x);
+            continue;
+        }
+        for (int x = start_x; x < end_x; x++) {
+            // RGB565'den grayscale'e dönüştür
+            uint8_t current_gray = lumaAt(current_frame, x, y);
+            uint8_t previous_gray = lumaAt(previous_frame, x, y);
+
+            total_change += abs(current_gray - previous_gray);
         }
     }
     
-    return (total_change > ROI_OPT_THRESHOLD * block_size * block_size);
+    return (total_change > (uint32_t)ROI_OPT_THRESHOLD * block_size * block_size);
 }
 // // ROI filtresi için sabitler
 // #define ROI_TH 0
@@ -68,10 +183,57 @@ static bool checkROIBlockChange(uint16_t *current_frame, uint16_t *previous_fram
 // #define ALARM_COLOR 0xF800  // Kırmızı renk (RGB565 formatında)
 // #define ALARM_DURATION_MS 1000 // Alarm süresi (ms)
 
-static uint8_t first_frame = 1; // İlk kare kontrolü
-static uint8_t first_frame_center = 1; // Merkez ROI için ilk kare kontrolü
-static uint32_t alarm_start_time = 0; // Alarm başlangıç zamanı
-static uint8_t alarm_active = 0; // Alarm durumu
+// Girişi (RGB565 veya Y8) aynı boyuttaki Y8 düzleme yaz
+static void convertToLuma(const ImageView *input, const ImageView *plane) {
+    if (input->format == IMAGE_FORMAT_Y8) {
+        for (int y = 0; y < input->height; y++) {
+            memcpy(imageViewRow8(plane, y), imageViewRow8(input, y), input->width);
+        }
+    } else if (input->stride == input->width && plane->stride == plane->width) {
+        convertToLumaPlane(input->data, plane->data, (uint32_t)input->width * input->height);
+    } else {
+        for (int y = 0; y < input->height; y++) {
+            convertToLumaPlane(imageViewRow16(input, y), imageViewRow8(plane, y), input->width);
+        }
+    }
+}
+
+// Luma geçmiş halkası: her kare halkanın sıradaki (en eski) yuvasına luma olarak yazılır ve
+// commit ile en yeni kare olur. Önceki kareler kopyalanmaz, sadece head indeksi ilerler.
+
+// age kare önceki luma düzlemi (0: bir önceki kare). Boyut farklıysa veya o kadar eski kare yoksa false.
+static bool historyPlane(const FilterContext *ctx, int width, int height, int age, ImageView *plane) {
+    if (age >= ctx->luma_ring_frames || width != ctx->luma_ring_width || height != ctx->luma_ring_height) {
+        return false;
+    }
+    int slot = (ctx->luma_ring_head + ctx->luma_ring_depth - age) % ctx->luma_ring_depth;
+    *plane = imageViewMake(ctx->luma_ring[slot], width, height, IMAGE_FORMAT_Y8);
+    return true;
+}
+
+// Girişin luma düzlemini halkanın sıradaki yuvasına yaz. Yuva yoksa veya yetmezse false.
+static bool loadHistoryPlane(FilterContext *ctx, const ImageView *input, ImageView *plane) {
+    if (ctx->luma_ring_depth == 0 || (uint32_t)input->width * input->height > ctx->luma_ring_plane_size) {
+        return false;
+    }
+    int slot = (ctx->luma_ring_head + 1) % ctx->luma_ring_depth;
+    *plane = imageViewMake(ctx->luma_ring[slot], input->width, input->height, IMAGE_FORMAT_Y8);
+    convertToLuma(input, plane);
+    return true;
+}
+
+// loadHistoryPlane ile yazılan düzlemi en yeni kare yap. Sıradaki yükleme en eski yuvanın
+// üzerine yazacağı için en fazla depth - 1 kare geriye bakılabilir.
+static void commitHistoryPlane(FilterContext *ctx, const ImageView *plane) {
+    if (plane->width != ctx->luma_ring_width || plane->height != ctx->luma_ring_height) {
+        // Boyut değişti, eski kareler karşılaştırılamaz
+        ctx->luma_ring_frames = 0;
+        ctx->luma_ring_width = plane->width;
+        ctx->luma_ring_height = plane->height;
+    }
+    ctx->luma_ring_head = (ctx->luma_ring_head + 1) % ctx->luma_ring_depth;
+    if (ctx->luma_ring_frames < ctx->luma_ring_depth - 1) ctx->luma_ring_frames++;
+}
 
 void applyKernel3x3_window(uint8_t window[3][3], const int kernel[3][3], int kernel_factor, int *result) {
     int32_t sum = 0;
@@ -84,56 +246,344 @@ void applyKernel3x3_window(uint8_t window[3][3], const int kernel[3][3], int ker
     *result = sum;
 }
 
-void applyFilterToImage(uint16_t *input_image, uint16_t *output_image, FilterType filter_type) {
-    // Geçici buffer için 3 satırlık alan
-    uint16_t line_buffer[3][IMG_COLUMNS];
+// Kayan sütun toplamlı 3x3 Laplacian (Gaussian ayrık binom yolundan geçer: gaussianBlurSeparable).
+// Her sütun için 3 satırın toplamı bir kez hesaplanır; pencere sağa kayarken
+// önceki iki sütun toplamı register'larda taşınır, her piksel için sadece yeni sütun okunur.
+// Sonuçlar applyKernel3x3_window ile birebir aynıdır. Kenar pikseller yazılmaz.
+// plane: Y8, output: RGB565, aynı boyutta.
+
+// Laplacian: 8*merkez - 8 komşu = 9*merkez - 3x3 toplam
+void convolveLaplacian3x3(const ImageView *plane, const ImageView *output) {
+    int width = plane->width;
+
+    for (int row = 1; row < plane->height - 1; row++) {
+        const uint8_t *top = imageViewRow8(plane, row - 1);
+        const uint8_t *mid = imageViewRow8(plane, row);
+        const uint8_t *bot = imageViewRow8(plane, row + 1);
+        uint16_t *out = imageViewRow16(output, row);
+
+        int32_t col_left = top[0] + mid[0] + bot[0];
+        int32_t col_center = top[1] + mid[1] + bot[1];
+
+        for (int col = 1; col < width - 1; col++) {
+            int32_t col_right = top[col + 1] + mid[col + 1] + bot[col + 1];
+            int32_t sum = 9 * mid[col] - (col_left + col_center + col_right);
+
+            if (sum > 255) sum = 255;
+            if (sum < 0) sum = 0;
+            out[col] = rgb565FromLuma(sum);
+
+            col_left = col_center;
+            col_center = col_right;
+        }
+    }
+}
+
+// Binom satırı (1 2 1 / 1 4 6 4 1 / 1 6 15 20 15 6 1), sadece toplama ve kaydırma ile
+static void blurRowHorizontal(const uint8_t *src, uint16_t *dst, int width, int size) {
+    int radius = size / 2;
+
+    switch (size) {
+    case 3:
+        for (int x = radius; x < width - radius; x++) {
+            dst[x] = src[x - 1] + (src[x] << 1) + src[x + 1];
+        }
+        break;
+    case 5:
+        for (int x = radius; x < width - radius; x++) {
+            uint16_t c = src[x];
+            dst[x] = (src[x - 2] + src[x + 2])
+                   + ((src[x - 1] + src[x + 1]) << 2)
+                   + (c << 2) + (c << 1);
+        }
+        break;
+    case 7:
+        for (int x = radius; x < width - radius; x++) {
+            uint16_t p1 = src[x - 2] + src[x + 2];
+            uint16_t p2 = src[x - 1] + src[x + 1];
+            uint16_t c = src[x];
+            dst[x] = (src[x - 3] + src[x + 3])
+                   + ((p1 << 2) + (p1 << 1))      // 6x
+                   + ((p2 << 4) - p2)             // 15x
+                   + ((c << 4) + (c << 2));       // 20x
+        }
+        break;
+    }
+}
+
+// Ayrık, sadece toplama/kaydırma kullanan Gaussian bulanıklaştırma (3x3, 5x5, 7x7 binom).
+// Önce her satır yatayda süzülüp kayan satır tamponuna yazılır, ardından dikeyde aynı binom
+// ile birleştirilir. 3x3 sonucu gaussian_kernel/gaussian_factor ile birebir aynıdır.
+// Kenardan size/2 genişliğindeki pikseller yazılmaz. rows: çağıranın verdiği kayan satır tamponu.
+void gaussianBlurSeparable(const ImageView *plane, const ImageView *output, int size,
+                           uint16_t rows_buffer[GAUSSIAN_MAX_SIZE][FILTER_MAX_WIDTH]) {
+    int width = plane->width;
+    int height = plane->height;
+    int radius = size / 2;
+    int shift = 2 * (size - 1);  // toplam ağırlık 2^(size-1) x 2^(size-1)
+    const uint16_t *rows[GAUSSIAN_MAX_SIZE];
+
+    if (size != 3 && size != 5 && size != 7) return;
+    if (width > FILTER_MAX_WIDTH || width < size || height < size) return;
+
+    for (int in_row = 0; in_row < height; in_row++) {
+        blurRowHorizontal(imageViewRow8(plane, in_row), rows_buffer[in_row % size], width, size);
+
+        if (in_row < size - 1) continue;
+
+        // Tampondaki en eski satırdan en yeniye sırala
+        int first = in_row - (size - 1);
+        for (int k = 0; k < size; k++) {
+            rows[k] = rows_buffer[(first + k) % size];
+        }
+
+        uint16_t *out = imageViewRow16(output, first + radius);
+
+        switch (size) {
+        case 3:
+            for (int x = radius; x < width - radius; x++) {
+                uint32_t sum = rows[0][x] + (rows[1][x] << 1) + rows[2][x];
+                out[x] = rgb565FromLuma(sum >> shift);
+            }
+            break;
+        case 5:
+            for (int x = radius; x < width - radius; x++) {
+                uint32_t c = rows[2][x];
+                uint32_t sum = (rows[0][x] + rows[4][x])
+                             + ((uint32_t)(rows[1][x] + rows[3][x]) << 2)
+                             + (c << 2) + (c << 1);
+                out[x] = rgb565FromLuma(sum >> shift);
+            }
+            break;
+        case 7:
+            for (int x = radius; x < width - radius; x++) {
+                uint32_t p1 = rows[1][x] + rows[5][x];
+                uint32_t p2 = rows[2][x] + rows[4][x];
+                uint32_t c = rows[3][x];
+                uint32_t sum = (rows[0][x] + rows[6][x])
+                             + ((p1 << 2) + (p1 << 1))
+                             + ((p2 << 4) - p2)
+                             + ((c << 4) + (c << 2));
+                out[x] = rgb565FromLuma(sum >> shift);
+            }
+            break;
+        }
+    }
+}
+
+// row_start..row_end satırlarının ilk ve son border pikselini siyah yap
+static void clearBorderColumns(const ImageView *output, int border, int row_start, int row_end) {
+    int width = output->width;
+
+    for (int row = row_start; row < row_end; row++) {
+        uint16_t *out = imageViewRow16(output, row);
+        for (int i = 0; i < border; i++) {
+            out[i] = 0x0000;                // Satırın başı
+            out[width - 1 - i] = 0x0000;    // Satırın sonu
+        }
+    }
+}
+
+// Laplacian veya seçili boyuttaki Gaussian'ı plane -> output üzerinde çalıştır (kenarlar yazılmaz)
+static void runKernel(FilterContext *ctx, const ImageView *plane, const ImageView *output, FilterType filter_type) {
+    if (filter_type == FILTER_LAPLACIAN) {
+        convolveLaplacian3x3(plane, output);
+    } else {
+        gaussianBlurSeparable(plane, output, ctx->gaussian_size, ctx->blur_rows);
+    }
+}
+
+// Referans luma düzlemi (halkanın en yeni yuvası) ve önceki çıkış varsa, ROI_OPT_BLOCK_SIZE'lık
+// bloklardan sadece referansa göre değişenleri yeniden hesaplar. Referansta bir blok sadece
+// yeniden hesaplandığında güncellenir, böylece eşiğin altında kalan yavaş kaymalar birikir ve
+// sonunda bloğu yeniler. Çıkış başka bir tampondaysa önce önceki çıkış kopyalanır. Bir bloktaki değişim çıkışta radius kadar taşar, bu yüzden
+// yazılan bölge blok + radius halo, okunan bölge blok + 2*radius'tur. Yan yana değişen bloklar
+// tek pencerede işlenir. Diğer pikseller önceki karenin çıkışında olduğu gibi kalır.
+// Önceki kare kullanılamıyorsa false döner, çağıran tüm kareyi işler ve plane'i commit eder.
+// true dönerse plane commit edilmemelidir, referans yerinde güncellenmiştir.
+static bool applyKernelIncremental(FilterContext *ctx, const ImageView *plane, const ImageView *output,
+                                   FilterType filter_type, int radius) {
+    int width = plane->width;
+    int height = plane->height;
+    int blocks_x = (width + ROI_OPT_BLOCK_SIZE - 1) / ROI_OPT_BLOCK_SIZE;
+    int blocks_y = (height + ROI_OPT_BLOCK_SIZE - 1) / ROI_OPT_BLOCK_SIZE;
+    ImageView previous;
+
+    if (!historyPlane(ctx, width, height, 0, &previous) || !ctx->has_output ||
+        ctx->last_output.width != width || ctx->last_output.height != height ||
+        blocks_x * blocks_y > ROI_OPT_MAX_BLOCKS) {
+        return false;
+    }
+
+    // Dönen çıkış tamponları (frame pool): değişmeyen bloklar önceki çıkıştan gelir
+    if (ctx->last_output.data != output->data) {
+        copyImage(&ctx->last_output, output);
+    }
+    damageClear(&ctx->damage, width, height);
+
+    // Blok değişim haritası
+    ctx->changed_blocks = 0;
+    for (int by = 0; by < blocks_y; by++) {
+        for (int bx = 0; bx < blocks_x; bx++) {
+            bool changed = checkROIBlockChange(plane, &previous, bx * ROI_OPT_BLOCK_SIZE,
+                                               by * ROI_OPT_BLOCK_SIZE, ROI_OPT_BLOCK_SIZE);
+            ctx->block_map[by * blocks_x + bx] = changed;
+            ctx->changed_blocks += changed;
+        }
+    }
+
+    for (int by = 0; by < blocks_y; by++) {
+        int bx = 0;
+        while (bx < blocks_x) {
+            if (!ctx->block_map[by * blocks_x + bx]) {
+                bx++;
+                continue;
+            }
+
+            // Aynı satırdaki ardışık değişen bloklar
+            int run_start = bx;
+            while (bx < blocks_x && ctx->block_map[by * blocks_x + bx]) bx++;
+
+            int x0 = run_start * ROI_OPT_BLOCK_SIZE - 2 * radius;
+            int x1 = bx * ROI_OPT_BLOCK_SIZE + 2 * radius;
+            int y0 = by * ROI_OPT_BLOCK_SIZE - 2 * radius;
+            int y1 = (by + 1) * ROI_OPT_BLOCK_SIZE + 2 * radius;
+            if (x0 < 0) x0 = 0;
+            if (y0 < 0) y0 = 0;
+            if (x1 > width) x1 = width;
+            if (y1 > height) y1 = height;
+
+            // Kernel pencerenin radius genişliğindeki kenarını yazmaz, kalan kısım blok + halo
+            ImageView in = imageViewSub(plane, x0, y0, x1 - x0, y1 - y0);
+            ImageView out = imageViewSub(output, x0, y0, x1 - x0, y1 - y0);
+            runKernel(ctx, &in, &out, filter_type);
+            damageAdd(&ctx->damage, x0, y0, x1 - x0, y1 - y0);
+        }
+    }
+
+    // Yeniden hesaplanan blokların referansı bu kareye ilerler, diğerleri eski değerinde kalır
+    for (int by = 0; by < blocks_y; by++) {
+        int y0 = by * ROI_OPT_BLOCK_SIZE;
+        int y1 = (y0 + ROI_OPT_BLOCK_SIZE < height) ? y0 + ROI_OPT_BLOCK_SIZE : height;
+        for (int bx = 0; bx < blocks_x; bx++) {
+            if (!ctx->block_map[by * blocks_x + bx]) continue;
+            int x0 = bx * ROI_OPT_BLOCK_SIZE;
+            int x1 = (x0 + ROI_OPT_BLOCK_SIZE < width) ? x0 + ROI_OPT_BLOCK_SIZE : width;
+            for (int y = y0; y < y1; y++) {
+                memcpy(&imageViewRow8(&previous, y)[x0], &imageViewRow8(plane, y)[x0], x1 - x0);
+            }
+        }
+    }
+
+    return true;
+}
+
+// Düşük kalite: kernel girişin her 2 satırından (HALF_RES'te ayrıca her 2 sütunundan) birinden
+// oluşan küçük luma düzleminde çalışır, sonuç en yakın komşu ile tam boyuta açılır.
+// Küçük çıkış, çıkış tamponunun çift satırlarının başına yazılır ve yerinde büyütülür.
+// Düzlem geçmiş halkasının sıradaki yuvasındadır ama commit edilmez, bu karede geçmiş tutulmaz.
+// Yuva yoksa veya küçük görüntü kernel'e yetmiyorsa false, çağıran tam kaliteyle işler.
+static bool applyKernelReduced(FilterContext *ctx, const ImageView *input, const ImageView *output,
+                               FilterType filter_type, int border) {
+    int step_x = (ctx->quality == FILTER_QUALITY_HALF_RES) ? 2 : 1;
+    int width = input->width / step_x;
+    int height = input->height / 2;
+
+    if (ctx->luma_ring_depth == 0 || (uint32_t)width * height > ctx->luma_ring_plane_size ||
+        width <= 2 * border || height <= 2 * border) return false;
+
+    int slot = (ctx->luma_ring_head + 1) % ctx->luma_ring_depth;
+    ImageView plane = imageViewMake(ctx->luma_ring[slot], width, height, IMAGE_FORMAT_Y8);
+    ImageView small = *output;
+    small.width = width;
+    small.height = height;
+    small.stride = output->stride * 2;
+
+    if (step_x == 1) {
+        ImageView rows = *input;
+        rows.height = height;
+        rows.stride = input->stride * 2;
+        convertToLuma(&rows, &plane);
+    } else {
+        for (int y = 0; y < height; y++) {
+            uint8_t *dst = imageViewRow8(&plane, y);
+            for (int x = 0; x < width; x++) {
+                dst[x] = lumaAt(input, x * 2, y * 2);
+            }
+        }
+    }
+
+    for (int i = 0; i < border; i++) {
+        memset(imageViewRow16(&small, i), 0, width * sizeof(uint16_t));
+        memset(imageViewRow16(&small, height - 1 - i), 0, width * sizeof(uint16_t));
+    }
+    clearBorderColumns(&small, border, border, height - border);
+    runKernel(ctx, &plane, &small, filter_type);
+
+    // Sağdan sola büyütme okunacak pikselleri ezmez; her satır altındaki satıra kopyalanır
+    for (int y = 0; y < height; y++) {
+        uint16_t *row = imageViewRow16(&small, y);
+        if (step_x == 2) {
+            for (int x = output->width - 1; x > 0; x--) {
+                int src = x / 2;
+                row[x] = row[src < width ? src : width - 1];
+            }
+        }
+        memcpy(imageViewRow16(output, 2 * y + 1), row, output->width * sizeof(uint16_t));
+    }
+    if (output->height % 2) {
+        memcpy(imageViewRow16(output, output->height - 1), imageViewRow16(output, output->height - 2),
+               output->width * sizeof(uint16_t));
+    }
+
+    ctx->has_output = false;
+    return true;
+}
+
+void applyFilterToImage(const ImageView *input, const ImageView *output, FilterType filter_type) {
+    int width = input->width;
+    int height = input->height;
+
+    if (!isFilterIOValid(input, output) || width > FILTER_MAX_WIDTH) return;
+
+    // Geçici buffer için 3 satırlık alan (kernel'ler için gri değerler).
+    // Görev stack'leri 512 byte, bu yüzden statik; fonksiyon aynı anda tek görevden çağrılmalı
+    static uint8_t line_buffer[3][FILTER_MAX_WIDTH];
     
     // Her satır için işlem yap
-    for (int row = 0; row < IMG_ROWS; row++) {
-        // Satırı line_buffer'a kopyala
-        memcpy(line_buffer[row % 3], &input_image[row * IMG_COLUMNS], IMG_COLUMNS * sizeof(uint16_t));
+    for (int row = 0; row < height; row++) {
+        uint16_t *out_row = imageViewRow16(output, row);
+
+        // Satırı gri olarak line_buffer'a al
+        for (int x = 0; x < width; x++) {
+            line_buffer[row % 3][x] = lumaAt(input, x, row);
+        }
         
         if (filter_type == FILTER_NONE) {
             // Filtre yoksa direkt kopyala
-            memcpy(&output_image[row * IMG_COLUMNS], line_buffer[row % 3], IMG_COLUMNS * sizeof(uint16_t));
+            for (int x = 0; x < width; x++) {
+                out_row[x] = rgb565At(input, x, row);
+            }
         } else if (filter_type == FILTER_GRAYSCALE) {
             // Grayscale dönüşümü
-            for (int x = 0; x < IMG_COLUMNS; x++) {
-                uint16_t rgb = line_buffer[row % 3][x];
-                uint8_t r = (rgb >> 11) & 0x1F;
-                uint8_t g = (rgb >> 5) & 0x3F;
-                uint8_t b = rgb & 0x1F;
-                
-                // RGB565'den 8-bit grayscale'e dönüşüm
-                uint8_t gray = (r * 299 + g * 587 + b * 114) / 1000;
-                
-                // Grayscale değeri RGB565 formatına geri dönüştür
-                uint8_t r5 = (gray * 31) / 255; // 5 bit
-                uint8_t g6 = (gray * 63) / 255; // 6 bit
-                uint8_t b5 = (gray * 31) / 255; // 5 bit
-                uint16_t rgb565 = (r5 << 11) | (g6 << 5) | b5;
-                
-                output_image[row * IMG_COLUMNS + x] = rgb565;
+            for (int x = 0; x < width; x++) {
+                // grayscale -> RGB565 (tablo ile)
+                out_row[x] = rgb565FromLuma(line_buffer[row % 3][x]);
             }
         } else if (row >= 2) {
             // Filtre uygulanabilir satırlar için
-            int y = row - 1;
+            uint16_t *out_prev = imageViewRow16(output, row - 1);
             const int (*kernel)[3] = (filter_type == FILTER_LAPLACIAN) ? laplacian_kernel : gaussian_kernel;
             int kernel_factor = (filter_type == FILTER_LAPLACIAN) ? 1 : gaussian_factor;
             
             // Kenar pikselleri hariç işlem yap
-            for (int x = 1; x < IMG_COLUMNS - 1; x++) {
+            for (int x = 1; x < width - 1; x++) {
                 uint8_t window[3][3];
                 
                 // 3x3 pencere oluştur
                 for (int i = -1; i <= 1; i++) {
                     for (int j = -1; j <= 1; j++) {
-                        uint16_t rgb = line_buffer[(row - 1 + i + 3) % 3][x + j];
-                        uint8_t r = (rgb >> 11) & 0x1F;
-                        uint8_t g = (rgb >> 5) & 0x3F;
-                        uint8_t b = rgb & 0x1F;
-                        uint8_t gray = (r * 299 + g * 587 + b * 114) / 1000;
-                        window[i + 1][j + 1] = gray;
+                        window[i + 1][j + 1] = line_buffer[(row - 1 + i + 3) % 3][x + j];
                     }
                 }
                 
@@ -142,94 +592,97 @@ void applyFilterToImage(uint16_t *input_image, uint16_t *output_image, FilterTyp
                 applyKernel3x3_window(window, kernel, kernel_factor, &result);
                 
                 // RGB565 formatına dönüştür
-                uint8_t r5 = (result * 31) / 255; // 5 bit
-                uint8_t g6 = (result * 63) / 255; // 6 bit
-                uint8_t b5 = (result * 31) / 255; // 5 bit
-                uint16_t rgb565 = (r5 << 11) | (g6 << 5) | b5;
-                
-                output_image[y * IMG_COLUMNS + x] = rgb565;
+                out_prev[x] = rgb565FromLuma(result);
             }
         } else {
             // İlk iki satır için siyah yap
-            for (int i = 0; i < IMG_COLUMNS; i++) {
-                output_image[row * IMG_COLUMNS + i] = 0x0000;
+            for (int i = 0; i < width; i++) {
+                out_row[i] = 0x0000;
             }
         }
     }
 }
 
-void applyFilterToImageFull(uint16_t *input_image, uint16_t *output_image, FilterType filter_type) {
+void applyFilterToImageFull(FilterContext *ctx, const ImageView *input, const ImageView *output, FilterType filter_type) {
+    int width = input->width;
+    int height = input->height;
+
+    if (!isFilterIOValid(input, output)) return;
+
+    // Filtre değiştiyse önceki filtrenin geçmişi ve alarmı kullanılmaz
+    if (filter_type != ctx->last_filter) {
+        filterContextReset(ctx);
+        ctx->last_filter = filter_type;
+    }
+
+    // Artımlı yollar değişen bölgeleri kendisi bildirir
+    damageSetFull(&ctx->damage, width, height);
+    ctx->overlay.active = false;
+
     if (filter_type == FILTER_NONE) {
         // Filtre yoksa direkt kopyala
-        memcpy(output_image, input_image, IMG_ROWS * IMG_COLUMNS * sizeof(uint16_t));
+        copyImage(input, output);
         return;
     }
 
     if (filter_type == FILTER_GRAYSCALE) {
         // Grayscale dönüşümü
-        for (int i = 0; i < IMG_ROWS * IMG_COLUMNS; i++) {
-            uint16_t rgb = input_image[i];
-            uint8_t r = (rgb >> 11) & 0x1F;
-            uint8_t g = (rgb >> 5) & 0x3F;
-            uint8_t b = rgb & 0x1F;
-            
-            // RGB565'den 8-bit grayscale'e dönüşüm
-            uint8_t gray = (r * 299 + g * 587 + b * 114) / 1000;
-            
-            // Grayscale değeri RGB565 formatına geri dönüştür
-            uint8_t r5 = (gray * 31) / 255; // 5 bit
-            uint8_t g6 = (gray * 63) / 255; // 6 bit
-            uint8_t b5 = (gray * 31) / 255; // 5 bit
-            uint16_t rgb565 = (r5 << 11) | (g6 << 5) | b5;
-            
-            output_image[i] = rgb565;
+        for (int y = 0; y < height; y++) {
+            uint16_t *out = imageViewRow16(output, y);
+            for (int x = 0; x < width; x++) {
+                // RGB565 -> grayscale -> RGB565 (tablo ile)
+                out[x] = rgb565FromLuma(lumaAt(input, x, y));
+            }
         }
         return;
     }
 
     if (filter_type == FILTER_ROI) {
-        uint16_t *previous_frame = (uint16_t *)PREVIOUS_FRAME_ADDR;
-
-        // İlk kareyi işle
-        if (first_frame) {
-            memcpy(output_image, input_image, IMG_ROWS * IMG_COLUMNS * sizeof(uint16_t));
-            memcpy(previous_frame, input_image, IMG_ROWS * IMG_COLUMNS * sizeof(uint16_t));
-            first_frame = 0;
+        ImageView current, previous;
+        bool loaded = loadHistoryPlane(ctx, input, &current);
+
+        // İlk kareyi işle (görüntü boyutu değiştiyse eski geçmiş kullanılmaz)
+        if (!loaded || !historyPlane(ctx, width, height, 0, &previous)) {
+            copyImage(input, output);
+            if (loaded) commitHistoryPlane(ctx, &current);
+            ctx->last_output = *output;
+            ctx->has_output = true;
             return;
         }
 
-        // Çıkış görüntüsünü siyah yap
-       // memset(output_image, 0, IMG_ROWS * IMG_COLUMNS * sizeof(uint16_t));
+        // Çıkış önceki çıkış + değişen bölgelerdir. Çıkış tamponları dönüyorsa (frame pool)
+        // önceki çıkış taşınır; önceki çıkış yoksa (filterPrime sonrası) giriş taşınır.
+        bool incremental = ctx->has_output && ctx->last_output.width == width &&
+                           ctx->last_output.height == height;
+        if (!incremental) {
+            copyImage(input, output);
+        } else {
+            if (ctx->last_output.data != output->data) {
+                copyImage(&ctx->last_output, output);
+            }
+            damageClear(&ctx->damage, width, height);
+        }
 
         // Her ROI_WIDTH ve ROI_HEIGHT piksel için kontrol yap
-        for (int y = ROI_HEIGHT; y < IMG_ROWS; y += ROI_HEIGHT) {
-            for (int x = ROI_WIDTH; x < IMG_COLUMNS; x += ROI_WIDTH) {
-                // Mevcut ve önceki pikselleri al
-                uint16_t current_rgb = input_image[y * IMG_COLUMNS + x];
-                uint16_t previous_rgb = previous_frame[y * IMG_COLUMNS + x];
-
-                // RGB565'den grayscale'e dönüştür
-                uint8_t current_gray = ((current_rgb >> 11) & 0x1F) * 299/1000 + 
-                                     ((current_rgb >> 5) & 0x3F) * 587/1000 + 
-                                     (current_rgb & 0x1F) * 114/1000;
-                
-                uint8_t previous_gray = ((previous_rgb >> 11) & 0x1F) * 299/1000 + 
-                                      ((previous_rgb >> 5) & 0x3F) * 587/1000 + 
-                                      (previous_rgb & 0x1F) * 114/1000;
+        for (int y = ROI_HEIGHT; y < height; y += ROI_HEIGHT) {
+            for (int x = ROI_WIDTH; x < width; x += ROI_WIDTH) {
+                // Mevcut ve önceki piksellerin gri değerleri
+                uint8_t current_gray = imageViewRow8(&current, y)[x];
+                uint8_t previous_gray = imageViewRow8(&previous, y)[x];
 
                 // XOR işlemi ve eşik kontrolü
                 uint8_t xor_result = current_gray ^ previous_gray;
                 if (xor_result > ROI_TH) {
                     // ROI bölgesini kopyala
+                    damageAdd(&ctx->damage, x - ROI_WIDTH, y - ROI_HEIGHT, 2 * ROI_WIDTH, 2 * ROI_HEIGHT);
                     for (int k = -ROI_HEIGHT; k < ROI_HEIGHT; k++) {
                         for (int j = -ROI_WIDTH; j < ROI_WIDTH; j++) {
                             int new_y = y + k;
                             int new_x = x + j;
                             
                             // Sınırları kontrol et
-                            if (new_y >= 0 && new_y < IMG_ROWS && new_x >= 0 && new_x < IMG_COLUMNS) {
-                                output_image[new_y * IMG_COLUMNS + new_x] = 
-                                    input_image[new_y * IMG_COLUMNS + new_x];
+                            if (new_y >= 0 && new_y < height && new_x >= 0 && new_x < width) {
+                                imageViewRow16(output, new_y)[new_x] = rgb565At(input, new_x, new_y);
                             }
                         }
                     }
@@ -237,77 +690,69 @@ void applyFilterToImageFull(uint16_t *input_image, uint16_t *output_image, Filte
             }
         }
 
-        // Mevcut kareyi önceki kare olarak sakla
-        memcpy(previous_frame, input_image, IMG_ROWS * IMG_COLUMNS * sizeof(uint16_t));
+        // Mevcut kare halkanın en yeni karesi olur (kopyalama yok)
+        commitHistoryPlane(ctx, &current);
+        ctx->last_output = *output;
+        ctx->has_output = true;
         return;
     }
 
     if (filter_type == FILTER_ROI_CENTER_ALARM) {
-        uint16_t *previous_frame = (uint16_t *)PREVIOUS_FRAME_ADDR;
+        ImageView current, previous;
         uint32_t current_time = osKernelGetTickCount(); // Mevcut zaman
 
+        // Merkez koordinatları hesapla
+        int center_x = width / 2;
+        int center_y = height / 2;
+        int roi_start_x = center_x - CENTER_ROI_SIZE/2;
+        int roi_start_y = center_y - CENTER_ROI_SIZE/2;
+
         // İlk kareyi işle
-        if (first_frame_center) {
-            memcpy(output_image, input_image, IMG_ROWS * IMG_COLUMNS * sizeof(uint16_t));
-            memcpy(previous_frame, input_image, IMG_ROWS * IMG_COLUMNS * sizeof(uint16_t));
-            first_frame_center = 0;
+        if (!historyPlane(ctx, width, height, 0, &previous)) {
+            copyImage(input, output);
+            if (loadHistoryPlane(ctx, input, &current)) commitHistoryPlane(ctx, &current);
+            ctx->alarm_active = false;
             return;
         }
 
-        // Önce mevcut görüntüyü kopyala
-        memcpy(output_image, input_image, IMG_ROWS * IMG_COLUMNS * sizeof(uint16_t));
-
-        // Eğer alarm aktifse ve süresi dolmamışsa, kırmızı ekranı göstermeye devam et
-        if (alarm_active) {
-            if ((current_time - alarm_start_time) < (ALARM_DURATION_MS / portTICK_PERIOD_MS)) {
-                // Önce mevcut görüntüyü kopyala
-                memcpy(output_image, input_image, IMG_ROWS * IMG_COLUMNS * sizeof(uint16_t));
-                
-                // Sadece merkez ROI bölgesini kırmızı yap
-                int center_x = IMG_COLUMNS / 2;
-                int center_y = IMG_ROWS / 2;
-                int roi_start_x = center_x - CENTER_ROI_SIZE/2;
-                int roi_start_y = center_y - CENTER_ROI_SIZE/2;
-                
-                for (int y = roi_start_y; y < roi_start_y + CENTER_ROI_SIZE && y < IMG_ROWS; y++) {
-                    for (int x = roi_start_x; x < roi_start_x + CENTER_ROI_SIZE && x < IMG_COLUMNS; x++) {
+        // Eğer alarm aktifse ve süresi dolmamışsa, kırmızı ekranı göstermeye devam et.
+        // Bu sürede geçmiş güncellenmez, alarm bitince alarm öncesi kareyle karşılaştırılır.
+        if (ctx->alarm_active) {
+            if ((current_time - ctx->alarm_start_time) < (ALARM_DURATION_MS / portTICK_PERIOD_MS)) {
+                copyImage(input, output);
+                // Sadece merkez ROI bölgesini kırmızı yap (panel overlay'inde ekran çizer)
+                if (ctx->panel_overlay) {
+                    setAlarmOverlay(ctx, roi_start_x, roi_start_y, CENTER_ROI_SIZE, CENTER_ROI_SIZE, width, height);
+                    return;
+                }
+                for (int y = roi_start_y; y < roi_start_y + CENTER_ROI_SIZE && y < height; y++) {
+                    for (int x = roi_start_x; x < roi_start_x + CENTER_ROI_SIZE && x < width; x++) {
                         if (y >= 0 && x >= 0) {
-                            output_image[y * IMG_COLUMNS + x] = ALARM_COLOR;
+                            imageViewRow16(output, y)[x] = ALARM_COLOR;
                         }
                     }
                 }
                 return;
             } else {
                 // Alarm süresi doldu
-                alarm_active = 0;
+                ctx->alarm_active = false;
             }
         }
 
-        // Merkez koordinatları hesapla
-        int center_x = IMG_COLUMNS / 2;
-        int center_y = IMG_ROWS / 2;
-        int roi_start_x = center_x - CENTER_ROI_SIZE/2;
-        int roi_start_y = center_y - CENTER_ROI_SIZE/2;
+        if (!loadHistoryPlane(ctx, input, &current)) {
+            copyImage(input, output);
+            return;
+        }
 
         // Merkez bölgedeki değişimi kontrol et
         int total_change = 0;
-        int pixel_count = 0;
 
-        for (int y = roi_start_y; y < roi_start_y + CENTER_ROI_SIZE && y < IMG_ROWS; y++) {
-            for (int x = roi_start_x; x < roi_start_x + CENTER_ROI_SIZE && x < IMG_COLUMNS; x++) {
+        for (int y = roi_start_y; y < roi_start_y + CENTER_ROI_SIZE && y < height; y++) {
+            for (int x = roi_start_x; x < roi_start_x + CENTER_ROI_SIZE && x < width; x++) {
                 if (y >= 0 && x >= 0) {  // Negatif indeksleri kontrol et
-                    // Mevcut ve önceki pikselleri al
-                    uint16_t current_rgb = input_image[y * IMG_COLUMNS + x];
-                    uint16_t previous_rgb = previous_frame[y * IMG_COLUMNS + x];
-
-                    // RGB565'den grayscale'e dönüştür
-                    uint8_t current_gray = ((current_rgb >> 11) & 0x1F) * 299/1000 + 
-                                         ((current_rgb >> 5) & 0x3F) * 587/1000 + 
-                                         (current_rgb & 0x1F) * 114/1000;
-                    
-                    uint8_t previous_gray = ((previous_rgb >> 11) & 0x1F) * 299/1000 + 
-                                          ((previous_rgb >> 5) & 0x3F) * 587/1000 + 
-                                          (previous_rgb & 0x1F) * 114/1000;
+                    // Mevcut ve önceki piksellerin gri değerleri
+                    uint8_t current_gray = imageViewRow8(&current, y)[x];
+                    uint8_t previous_gray = imageViewRow8(&previous, y)[x];
 
                     // Değişim miktarını hesapla
                     total_change += (current_gray ^ previous_gray);
@@ -324,66 +769,225 @@ void applyFilterToImageFull(uint16_t *input_image, uint16_t *output_image, Filte
         // Ortalama değişimi hesapla
         float average_change = total_change;
 
-        // Eğer değişim eşiği geçerse, alarmı başlat
+        // Eğer değişim eşiği geçerse, alarmı başlat (tüm kare kırmızı), değilse kareyi aynen göster
         if (average_change > CENTER_ROI_TH) {
-            alarm_active = 1;
-            alarm_start_time = current_time;
-            for (int i = 0; i < IMG_ROWS * IMG_COLUMNS; i++) {
-                output_image[i] = ALARM_COLOR;
+            ctx->alarm_active = true;
+            ctx->alarm_start_time = current_time;
+            if (ctx->panel_overlay) {
+                // Kare hiç yazılmaz, ekran tüm paneli alarm rengiyle doldurur. Yazılmayan çıkış
+                // sonraki karelerde önceki çıkış olarak kullanılamaz.
+                setAlarmOverlay(ctx, 0, 0, width, height, width, height);
+                ctx->has_output = false;
+            } else {
+                for (int y = 0; y < height; y++) {
+                    uint16_t *out = imageViewRow16(output, y);
+                    for (int x = 0; x < width; x++) {
+                        out[x] = ALARM_COLOR;
+                    }
+                }
             }
+        } else {
+            copyImage(input, output);
         }
 
-        // Mevcut kareyi önceki kare olarak sakla
-        memcpy(previous_frame, input_image, IMG_ROWS * IMG_COLUMNS * sizeof(uint16_t));
+        // Mevcut kare halkanın en yeni karesi olur (kopyalama yok)
+        commitHistoryPlane(ctx, &current);
         return;
     }
 
-    // Kernel seçimi
-    const int (*kernel)[3] = (filter_type == FILTER_LAPLACIAN) ? laplacian_kernel : gaussian_kernel;
-    int kernel_factor = (filter_type == FILTER_LAPLACIAN) ? 1 : gaussian_factor;
+    // Laplacian 1 piksel, Gaussian kernel yarıçapı kadar kenar siyah kalır (aynı zamanda kernel yarıçapı)
+    int border = (filter_type == FILTER_LAPLACIAN) ? 1 : ctx->gaussian_size / 2;
 
-    // İlk iki satırı siyah yap
-    for (int i = 0; i < 2 * IMG_COLUMNS; i++) {
-        output_image[i] = 0x0000;
+    if (width > FILTER_MAX_WIDTH || (uint32_t)width * height > FILTER_MAX_PIXELS ||
+        width <= 2 * border || height <= 2 * border) return;
+
+    if (ctx->quality != FILTER_QUALITY_FULL &&
+        applyKernelReduced(ctx, input, output, filter_type, border)) return;
+
+    // Önce tüm kareyi tek geçişte geçmiş halkasının sıradaki luma düzlemine çevir, kernel'ler
+    // 8-bit veri üzerinde çalışsın. Halka yoksa Y8 giriş doğrudan kullanılır, geçmiş tutulmaz.
+    ImageView plane;
+    bool loaded = loadHistoryPlane(ctx, input, &plane);
+    if (!loaded) {
+        if (input->format != IMAGE_FORMAT_Y8) return;
+        plane = *input;
     }
 
-    // Son iki satırı siyah yap
-    for (int i = (IMG_ROWS - 2) * IMG_COLUMNS; i < IMG_ROWS * IMG_COLUMNS; i++) {
-        output_image[i] = 0x0000;
+    // ROI optimizasyonu açıksa önceki kareye göre sadece değişen bloklar işlenir
+    bool done = ctx->roi_optimization && loaded &&
+                applyKernelIncremental(ctx, &plane, output, filter_type, border);
+
+    // Tüm kare işlendiyse bu karenin luma düzlemi yeni referans olur, artımlı karede referans
+    // zaten blok blok güncellendi. Çıkış sonraki artımlı kare için saklanır.
+    if (loaded && !done) commitHistoryPlane(ctx, &plane);
+    ctx->last_output = *output;
+    ctx->has_output = loaded;
+    if (done) return;
+
+    // Üst ve alt kenar satırlarını siyah yap
+    for (int i = 0; i < border; i++) {
+        memset(imageViewRow16(output, i), 0, width * sizeof(uint16_t));
+        memset(imageViewRow16(output, height - 1 - i), 0, width * sizeof(uint16_t));
     }
 
-    // Kenar pikselleri hariç tüm görüntüyü işle
-    for (int row = 1; row < IMG_ROWS - 1; row++) {
-        // İşlenen satırın ilk ve son pikselleri siyah yap
-        output_image[row * IMG_COLUMNS] = 0x0000;                    // Satırın ilk pikseli
-        output_image[row * IMG_COLUMNS + (IMG_COLUMNS - 1)] = 0x0000; // Satırın son pikseli
+    // İşlenen satırların ilk ve son pikselleri siyah
+    clearBorderColumns(output, border, border, height - border);
 
-        for (int col = 1; col < IMG_COLUMNS - 1; col++) {
-            uint8_t window[3][3];
-            
-            // 3x3 pencere oluştur
-            for (int i = -1; i <= 1; i++) {
-                for (int j = -1; j <= 1; j++) {
-                    uint16_t rgb = input_image[(row + i) * IMG_COLUMNS + (col + j)];
-                    uint8_t r = (rgb >> 11) & 0x1F;
-                    uint8_t g = (rgb >> 5) & 0x3F;
-                    uint8_t b = rgb & 0x1F;
-                    uint8_t gray = (r * 299 + g * 587 + b * 114) / 1000;
-                    window[i + 1][j + 1] = gray;
-                }
+    // Kenar pikselleri hariç tüm görüntüyü kernel'e özel döngüyle işle
+    runKernel(ctx, &plane, output, filter_type);
+}
+
+bool filterPassthrough(FilterContext *ctx, FilterType filter_type) {
+    if (filter_type != FILTER_NONE) return false;
+
+    // Kopya yapılmadığı için önceki çıkış da artık bu context'in değil
+    if (filter_type != ctx->last_filter) {
+        filterContextReset(ctx);
+        ctx->last_filter = filter_type;
+    }
+    ctx->has_output = false;
+    return true;
+}
+
+void filterPrime(FilterContext *ctx, const ImageView *input, FilterType filter_type) {
+    ImageView plane;
+
+    if (filter_type == ctx->last_filter) return;  // Geçmiş zaten bu filtrenin
+
+    filterContextReset(ctx);
+    ctx->last_filter = filter_type;
+
+    bool kernel = filter_type == FILTER_LAPLACIAN || filter_type == FILTER_GAUSSIAN;
+    bool uses_history = filter_type == FILTER_ROI || filter_type == FILTER_ROI_CENTER_ALARM ||
+                        (kernel && ctx->roi_optimization);
+    if (!uses_history || !imageViewIsValid(input)) return;
+
+    if (loadHistoryPlane(ctx, input, &plane)) commitHistoryPlane(ctx, &plane);
+}
+
+// Şerit modu: kare üstten alta satır satır gelirken her yeni şerit hemen filtrelenir.
+// Kernel'ler yarıçap kadar alt satıra ihtiyaç duyduğu için çıkış girişin radius satır gerisindedir.
+// Sonuç applyFilterToImageFull ile aynıdır.
+bool filterStripBegin(FilterContext *ctx, const ImageView *input, const ImageView *output, FilterType filter_type) {
+    ctx->strip_active = false;
+
+    if (!isFilterIOValid(input, output) || input->width > FILTER_MAX_WIDTH) return false;
+
+    // Önceki kareyle karşılaştıran filtreler tüm kareyi bekler
+    bool kernel = filter_type == FILTER_LAPLACIAN || filter_type == FILTER_GAUSSIAN;
+    if (!kernel && filter_type != FILTER_NONE && filter_type != FILTER_GRAYSCALE) return false;
+    if (kernel && (ctx->roi_optimization || ctx->quality != FILTER_QUALITY_FULL)) return false;
+
+    if (filter_type != ctx->last_filter) {
+        filterContextReset(ctx);
+        ctx->last_filter = filter_type;
+    }
+
+    ctx->strip_input = *input;
+    ctx->strip_output = *output;
+    ctx->strip_filter = filter_type;
+    ctx->strip_border = 0;
+    ctx->strip_rows_in = 0;
+    ctx->strip_rows_out = 0;
+    ctx->strip_loaded = false;
+
+    if (kernel) {
+        int border = (filter_type == FILTER_LAPLACIAN) ? 1 : ctx->gaussian_size / 2;
+        int height = input->height;
+
+        if ((uint32_t)input->width * height > FILTER_MAX_PIXELS ||
+            input->width <= 2 * border || height <= 2 * border) return false;
+
+        // Luma düzlemi geçmiş halkasının sıradaki yuvası, satırlar geldikçe doldurulur
+        if (ctx->luma_ring_depth != 0 && (uint32_t)input->width * height <= ctx->luma_ring_plane_size) {
+            int slot = (ctx->luma_ring_head + 1) % ctx->luma_ring_depth;
+            ctx->strip_plane = imageViewMake(ctx->luma_ring[slot], input->width, height, IMAGE_FORMAT_Y8);
+            ctx->strip_loaded = true;
+        } else if (input->format == IMAGE_FORMAT_Y8) {
+            ctx->strip_plane = *input;
+        } else {
+            return false;
+        }
+
+        // Üst kenar satırları girişe bağlı değil
+        for (int i = 0; i < border; i++) {
+            memset(imageViewRow16(output, i), 0, input->width * sizeof(uint16_t));
+        }
+        ctx->strip_border = border;
+        ctx->strip_rows_out = border;
+    }
+
+    damageSetFull(&ctx->damage, input->width, input->height);
+    ctx->overlay.active = false;
+    ctx->strip_active = true;
+    return true;
+}
+
+uint16_t filterStripProcess(FilterContext *ctx, uint16_t rows_ready) {
+    const ImageView *input = &ctx->strip_input;
+    const ImageView *output = &ctx->strip_output;
+    int width = input->width;
+    int height = input->height;
+    int border = ctx->strip_border;
+
+    if (!ctx->strip_active) return ctx->strip_rows_out;
+    if (rows_ready > height) rows_ready = height;
+    if (rows_ready <= ctx->strip_rows_in) return ctx->strip_rows_out;
+
+    int first = ctx->strip_rows_in;
+    int rows = rows_ready - first;
+    ctx->strip_rows_in = rows_ready;
+
+    if (ctx->strip_filter == FILTER_NONE) {
+        ImageView in = imageViewSub(input, 0, first, width, rows);
+        ImageView out = imageViewSub(output, 0, first, width, rows);
+        copyImage(&in, &out);
+        ctx->strip_rows_out = rows_ready;
+        return ctx->strip_rows_out;
+    }
+
+    if (ctx->strip_filter == FILTER_GRAYSCALE) {
+        for (int y = first; y < rows_ready; y++) {
+            uint16_t *out = imageViewRow16(output, y);
+            for (int x = 0; x < width; x++) {
+                out[x] = rgb565FromLuma(lumaAt(input, x, y));
             }
-            
-            // Kernel uygula
-            int result;
-            applyKernel3x3_window(window, kernel, kernel_factor, &result);
-            
-            // RGB565 formatına dönüştür
-            uint8_t r5 = (result * 31) / 255; // 5 bit
-            uint8_t g6 = (result * 63) / 255; // 6 bit
-            uint8_t b5 = (result * 31) / 255; // 5 bit
-            uint16_t rgb565 = (r5 << 11) | (g6 << 5) | b5;
-            
-            output_image[row * IMG_COLUMNS + col] = rgb565;
         }
+        ctx->strip_rows_out = rows_ready;
+        return ctx->strip_rows_out;
+    }
+
+    if (ctx->strip_loaded) {
+        ImageView in = imageViewSub(input, 0, first, width, rows);
+        ImageView plane_rows = imageViewSub(&ctx->strip_plane, 0, first, width, rows);
+        convertToLuma(&in, &plane_rows);
+    }
+
+    // Alt kenar dışındaki satırlar, altlarında radius satır varsa hesaplanabilir
+    int out_end = (rows_ready == height) ? height - border : rows_ready - border;
+    if (out_end > ctx->strip_rows_out) {
+        int window_start = ctx->strip_rows_out - border;
+        int window_end = out_end + border;
+        ImageView in = imageViewSub(&ctx->strip_plane, 0, window_start, width, window_end - window_start);
+        ImageView out = imageViewSub(output, 0, window_start, width, window_end - window_start);
+
+        clearBorderColumns(output, border, ctx->strip_rows_out, out_end);
+        runKernel(ctx, &in, &out, ctx->strip_filter);
+        ctx->strip_rows_out = out_end;
+    }
+
+    if (rows_ready == height) {
+        for (int i = 0; i < border; i++) {
+            memset(imageViewRow16(output, height - 1 - i), 0, width * sizeof(uint16_t));
+        }
+        ctx->strip_rows_out = height;
+        ctx->strip_active = false;
+
+        // Tam kareyle aynı şekilde geçmişe yazılır, sonraki kareler için karşılaştırılabilir
+        if (ctx->strip_loaded) commitHistoryPlane(ctx, &ctx->strip_plane);
+        ctx->last_output = *output;
+        ctx->has_output = ctx->strip_loaded;
     }
+
+    return ctx->strip_rows_out;
 }
@@ -0,0 +1,76 @@
+#include "filter_kernels.h"
+#include "stm32f4xx.h"  // CMSIS SIMD intrinsic'leri (__SMLAD, __PKHBT, __PKHTB, __USUB8, __SEL, __USADA8)
+
+// n / 1000 yerine (n * 33555) >> 25; n <= 31*299 + 63*587 + 31*114 aralığında birebir aynı
+#define LUMA_DIV1000_MUL   33555
+#define LUMA_DIV1000_SHIFT 25
+
+/* Referans (saf C) çekirdekler ---------------------------------------------*/
+
+void kernelLumaFromRGB565_ref(const uint16_t *src, uint8_t *dst, uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        uint16_t rgb = src[i];
+        uint8_t r = (rgb >> 11) & 0x1F;
+        uint8_t g = (rgb >> 5) & 0x3F;
+        uint8_t b = rgb & 0x1F;
+        dst[i] = (r * 299 + g * 587 + b * 114) / 1000;
+    }
+}
+
+uint32_t kernelAbsDiff_ref(const uint8_t *a, const uint8_t *b, uint8_t *dst, uint32_t count) {
+    uint32_t sad = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        uint8_t d = (a[i] > b[i]) ? (a[i] - b[i]) : (b[i] - a[i]);
+        dst[i] = d;
+        sad += d;
+    }
+    return sad;
+}
+
+/* Cortex-M4 DSP (SIMD) çekirdekler -----------------------------------------*/
+#if FILTER_KERNELS_HAVE_DSP
+
+// Bir 32-bit kelimedeki iki RGB565 pikselin gri değerleri, lo: piksel 0, hi: piksel 1
+static inline uint32_t lumaPair(uint32_t pixels) {
+    const uint32_t coef_rg = 299 | (587 << 16);
+    uint32_t r = (pixels >> 11) & 0x001F001F;
+    uint32_t g = (pixels >> 5) & 0x003F003F;
+    uint32_t b114 = (pixels & 0x001F001F) * 114;  // iki yarım kelime, taşma yok (31*114 < 65536)
+
+    uint32_t n0 = __SMLAD(__PKHBT(r, g, 16), coef_rg, b114 & 0xFFFF);
+    uint32_t n1 = __SMLAD(__PKHTB(g, r, 16), coef_rg, b114 >> 16);
+
+    return ((n0 * LUMA_DIV1000_MUL) >> LUMA_DIV1000_SHIFT)
+         | (((n1 * LUMA_DIV1000_MUL) >> LUMA_DIV1000_SHIFT) << 16);
+}
+
+void kernelLumaFromRGB565_dsp(const uint16_t *src, uint8_t *dst, uint32_t count) {
+    uint32_t i = 0;
+
+    // 4 piksel: iki kelime oku, dört gri değeri tek kelimede yaz
+    for (; i + 4 <= count; i += 4) {
+        uint32_t y01 = lumaPair(__UNALIGNED_UINT32_READ(&src[i]));
+        uint32_t y23 = lumaPair(__UNALIGNED_UINT32_READ(&src[i + 2]));
+        __UNALIGNED_UINT32_WRITE(&dst[i], ((y01 | (y01 >> 8)) & 0xFFFF) | ((y23 | (y23 >> 8)) << 16));
+    }
+
+    kernelLumaFromRGB565_ref(&src[i], &dst[i], count - i);
+}
+
+uint32_t kernelAbsDiff_dsp(const uint8_t *a, const uint8_t *b, uint8_t *dst, uint32_t count) {
+    uint32_t sad = 0;
+    uint32_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        uint32_t wa = __UNALIGNED_UINT32_READ(&a[i]);
+        uint32_t wb = __UNALIGNED_UINT32_READ(&b[i]);
+        uint32_t a_minus_b = __USUB8(wa, wb);
+        uint32_t b_minus_a = __USUB8(wb, wa);       // GE: b >= a olan baytlar
+        __UNALIGNED_UINT32_WRITE(&dst[i], __SEL(b_minus_a, a_minus_b));
+        sad = __USADA8(wa, wb, sad);
+    }
+
+    return sad + kernelAbsDiff_ref(&a[i], &b[i], &dst[i], count - i);
+}
+
+#endif /* FILTER_KERNELS_HAVE_DSP */
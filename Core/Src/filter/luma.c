@@ -0,0 +1,50 @@
+#include "luma.h"
+#include "filter_kernels.h"
+
+__attribute__((section(".sdram"))) uint8_t luma_from_rgb565[LUMA_TABLE_SIZE];
+uint16_t rgb565_from_luma[LUMA_LEVELS];
+
+void initLumaTables(void) {
+    // RGB565'den 8-bit grayscale'e dönüşüm (filtrelerin eski formülüyle birebir aynı)
+    for (uint32_t rgb = 0; rgb < LUMA_TABLE_SIZE; rgb++) {
+        uint8_t r = (rgb >> 11) & 0x1F;
+        uint8_t g = (rgb >> 5) & 0x3F;
+        uint8_t b = rgb & 0x1F;
+        luma_from_rgb565[rgb] = (r * 299 + g * 587 + b * 114) / 1000;
+    }
+
+    // Grayscale değeri RGB565 formatına geri dönüştür
+    for (uint32_t gray = 0; gray < LUMA_LEVELS; gray++) {
+        uint8_t r5 = (gray * 31) / 255; // 5 bit
+        uint8_t g6 = (gray * 63) / 255; // 6 bit
+        uint8_t b5 = (gray * 31) / 255; // 5 bit
+        rgb565_from_luma[gray] = (r5 << 11) | (g6 << 5) | b5;
+    }
+}
+
+void convertToLumaPlane(const uint16_t *image, uint8_t *plane, uint32_t pixel_count) {
+#if FILTER_KERNELS_USE_DSP && FILTER_KERNELS_HAVE_DSP
+    // SIMD aritmetik sürüm SDRAM'deki tabloya rastgele erişimden daha hızlı
+    kernelLumaFromRGB565(image, plane, pixel_count);
+#else
+    uint32_t i = 0;
+
+    // 4 piksel: iki 32-bit okuma, bir 32-bit yazma
+    if ((((uintptr_t)image | (uintptr_t)plane) & 3) == 0) {
+        const uint32_t *src = (const uint32_t *)image;
+        uint32_t *dst = (uint32_t *)plane;
+        for (; i + 4 <= pixel_count; i += 4) {
+            uint32_t p01 = *src++;
+            uint32_t p23 = *src++;
+            *dst++ = (uint32_t)luma_from_rgb565[p01 & 0xFFFF]
+                   | ((uint32_t)luma_from_rgb565[p01 >> 16] << 8)
+                   | ((uint32_t)luma_from_rgb565[p23 & 0xFFFF] << 16)
+                   | ((uint32_t)luma_from_rgb565[p23 >> 16] << 24);
+        }
+    }
+
+    for (; i < pixel_count; i++) {
+        plane[i] = luma_from_rgb565[image[i]];
+    }
+#endif
+}
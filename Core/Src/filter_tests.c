@@ -0,0 +1,971 @@
+#include "filter_tests.h"
+#include "main.h"  // SDRAM_BANK_ADDR (host derlemesinde tanımsız)
+#include <string.h>
+#include <stdlib.h>
+#include "filter.h"
+#include "luma.h"
+#include "filter_kernels.h"
+#include "frame_pool.h"
+#include "frame_mailbox.h"
+#include "profiler.h"
+#include "quality_controller.h"
+#include "pipeline_command.h"
+#include "boot_sequencer.h"
+
+// Test görüntüsü boyutları
+#define TEST_WIDTH 32
+#define TEST_HEIGHT 32
+#define TEST_STRIDE 48
+#define ROI_TEST_WIDTH 96   // 3x2 ROI_OPT_BLOCK_SIZE blok
+#define ROI_TEST_HEIGHT 64
+
+// Test sonuçları için renkli çıktı
+#define ANSI_COLOR_GREEN   "\x1b[32m"
+#define ANSI_COLOR_RED     "\x1b[31m"
+#define ANSI_COLOR_RESET   "\x1b[0m"
+
+// Test sonuçları (debugger'dan okunur)
+uint8_t grayscale_success, laplacian_success, roiopt_success, roidrift_success, roialarm_success;
+uint8_t kernel_equiv_success, kernel_simd_success, image_view_success, filter_context_success;
+uint8_t frame_pool_success, frame_mailbox_success, filter_strip_success, profiler_success;
+uint8_t quality_success, pipeline_command_success, boot_success, damage_success, alarm_overlay_success;
+static FilterContext test_filter;
+static uint8_t test_planes[2][TEST_WIDTH * TEST_HEIGHT];
+
+const FilterTestResult filter_test_results[] = {
+    {"grayscale", &grayscale_success},
+    {"laplacian", &laplacian_success},
+    {"roiopt", &roiopt_success},
+    {"roidrift", &roidrift_success},
+    {"roialarm", &roialarm_success},
+    {"kernel_equiv", &kernel_equiv_success},
+    {"kernel_simd", &kernel_simd_success},
+    {"image_view", &image_view_success},
+    {"filter_context", &filter_context_success},
+    {"frame_pool", &frame_pool_success},
+    {"frame_mailbox", &frame_mailbox_success},
+    {"filter_strip", &filter_strip_success},
+    {"profiler", &profiler_success},
+    {"quality", &quality_success},
+    {"pipeline_command", &pipeline_command_success},
+    {"boot", &boot_success},
+    {"damage", &damage_success},
+    {"alarm_overlay", &alarm_overlay_success},
+};
+const uint32_t filter_test_result_count = sizeof(filter_test_results) / sizeof(filter_test_results[0]);
+
+static void testCenterROIAlarm(void);
+static void createTestImage(uint16_t *image, int pattern);
+static int compareImages(uint16_t *img1, uint16_t *img2, int size);
+static void testGrayscaleFilter(void);
+static void testLaplacianFilter(void);
+static void testROIOptimization(void);
+static void testROIDrift(void);
+static void testKernelEquivalence(void);
+static void testKernelSIMD(void);
+static void testImageView(void);
+static void testFilterContext(void);
+static void testFramePool(void);
+static void testFrameMailbox(void);
+static void testFilterStrip(void);
+static void testProfiler(void);
+static void testQualityController(void);
+static void testPipelineCommand(void);
+static void testBootSequencer(void);
+static void testDamage(void);
+static void testAlarmOverlay(void);
+static void applyTestFilter(uint16_t *input, uint16_t *output, FilterType filter_type);
+
+// Ana test fonksiyonu
+void runFilterTests(void) {
+    grayscale_success = 0;
+    laplacian_success = 0;
+    roiopt_success = 0;
+    roidrift_success = 0;
+    roialarm_success = 0;
+    kernel_equiv_success = 0;
+    kernel_simd_success = 0;
+    image_view_success = 0;
+    filter_context_success = 0;
+    frame_pool_success = 0;
+    frame_mailbox_success = 0;
+    filter_strip_success = 0;
+    profiler_success = 0;
+    quality_success = 0;
+    pipeline_command_success = 0;
+    boot_success = 0;
+    damage_success = 0;
+    alarm_overlay_success = 0;
+
+    filterContextInit(&test_filter, test_planes[0], sizeof(test_planes[0]), 2);
+
+    testGrayscaleFilter();
+    
+    testLaplacianFilter();
+    
+    testROIOptimization();
+
+    testROIDrift();
+    
+    testCenterROIAlarm();
+
+    testKernelEquivalence();
+
+    testKernelSIMD();
+
+    testImageView();
+
+    testFilterContext();
+
+    testFramePool();
+
+    testFrameMailbox();
+
+    testFilterStrip();
+
+    testProfiler();
+
+    testQualityController();
+
+    testPipelineCommand();
+
+    testBootSequencer();
+
+    testDamage();
+
+    testAlarmOverlay();
+}
+
+// Test görüntüsü oluşturma
+static void createTestImage(uint16_t *image, int pattern) {
+    for (int y = 0; y < TEST_HEIGHT; y++) {
+        for (int x = 0; x < TEST_WIDTH; x++) {
+            switch (pattern) {
+                case 0: // Düz gri
+                    image[y * TEST_WIDTH + x] = 0x8410; // RGB565 format
+                    break;
+                case 1: // Dikey çizgiler
+                    image[y * TEST_WIDTH + x] = (x % 2) ? 0xFFFF : 0x0000;
+                    break;
+                case 2: // Yatay çizgiler
+                    image[y * TEST_WIDTH + x] = (y % 2) ? 0xFFFF : 0x0000;
+                    break;
+                case 3: // Dama tahtası
+                    image[y * TEST_WIDTH + x] = ((x + y) % 2) ? 0xFFFF : 0x0000;
+                    break;
+            }
+        }
+    }
+}
+
+// TEST_WIDTH x TEST_HEIGHT sıkışık RGB565 tamponları view ile filtrele
+static void applyTestFilter(uint16_t *input, uint16_t *output, FilterType filter_type) {
+    ImageView in = imageViewMake(input, TEST_WIDTH, TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    ImageView out = imageViewMake(output, TEST_WIDTH, TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    applyFilterToImageFull(&test_filter, &in, &out, filter_type);
+}
+
+// Test sonucu kontrolü
+static int compareImages(uint16_t *img1, uint16_t *img2, int size) {
+    int diff = 0;
+    for (int i = 0; i < size; i++) {
+        if (img1[i] != img2[i]) diff++;
+    }
+    return diff;
+}
+
+// Grayscale filtre testi: her çıkış pikseli girişin luma değerinin gri RGB565 karşılığı olmalı
+static void testGrayscaleFilter(void) {
+    uint16_t input[TEST_WIDTH * TEST_HEIGHT];
+    uint16_t output[TEST_WIDTH * TEST_HEIGHT];
+    uint16_t expected[TEST_WIDTH * TEST_HEIGHT];
+    int errors = 0;
+
+    // printf("Test: Grayscale Filtresi\n");
+
+    // Test 1: Düz gri görüntü, çıkış da düz olmalı
+    createTestImage(input, 0);
+    memset(output, 0, sizeof(output));
+    applyTestFilter(input, output, FILTER_GRAYSCALE);
+    for (int i = 0; i < TEST_WIDTH * TEST_HEIGHT; i++) expected[i] = output[0];
+    errors += compareImages(output, expected, TEST_WIDTH * TEST_HEIGHT) != 0;
+
+    // Test 2: Siyah-beyaz dama tahtası ve renkli bir blok
+    createTestImage(input, 3);
+    for (int y = 8; y < 16; y++) {
+        for (int x = 8; x < 16; x++) {
+            input[y * TEST_WIDTH + x] = 0xF800;  // Saf kırmızı
+        }
+    }
+    memset(output, 0, sizeof(output));
+    applyTestFilter(input, output, FILTER_GRAYSCALE);
+
+    for (int i = 0; i < TEST_WIDTH * TEST_HEIGHT; i++) {
+        expected[i] = rgb565FromLuma(lumaFromRGB565(input[i]));
+    }
+    errors += compareImages(output, expected, TEST_WIDTH * TEST_HEIGHT) != 0;
+
+    // Beyaz ve kırmızı hücreler gri olmalı: R == B, G (6 bit) yuvarlamayla 2*R ve giriş rengi kalmamalı
+    static const int cells[2] = { 1, 8 * TEST_WIDTH + 8 };
+    for (int k = 0; k < 2; k++) {
+        uint16_t pixel = output[cells[k]];
+        uint8_t r5 = pixel >> 11, g6 = (pixel >> 5) & 0x3F, b5 = pixel & 0x1F;
+        errors += r5 != b5 || abs(g6 - 2 * r5) > 2;
+        errors += pixel == input[cells[k]];
+    }
+
+    grayscale_success = errors == 0 ? 1 : 0;
+}
+
+// Laplacian filtre testi
+static void testLaplacianFilter(void) {
+    uint16_t input[TEST_WIDTH * TEST_HEIGHT];
+    uint16_t output[TEST_WIDTH * TEST_HEIGHT];
+    
+    // printf("Test: Laplacian Filtresi\n");
+    
+    // Test 1: Düz gri görüntü
+    createTestImage(input, 0);
+    memset(output, 0, sizeof(output));
+    applyTestFilter(input, output, FILTER_LAPLACIAN);
+    
+    // Düz görüntüde kenar olmamalı
+    int edges = 0;
+    for (int i = 0; i < TEST_WIDTH * TEST_HEIGHT; i++) {
+        if (output[i] > 0x1000) edges++; // Belirgin kenar eşiği
+    }
+    
+    // printf("  Test 1 (Düz Gri): %s%s%s\n",
+    //        edges < TEST_WIDTH ? ANSI_COLOR_GREEN : ANSI_COLOR_RED,
+    //        edges < TEST_WIDTH ? "BAŞARILI" : "BAŞARISIZ",
+    //        ANSI_COLOR_RESET);
+    
+    // Test 2: Dikey çizgiler
+    createTestImage(input, 1);
+    memset(output, 0, sizeof(output));
+    applyTestFilter(input, output, FILTER_LAPLACIAN);
+    
+    // Dikey kenarlarda yüksek değerler olmalı
+    edges = 0;
+    for (int i = 0; i < TEST_WIDTH * TEST_HEIGHT; i++) {
+        if (output[i] > 0x1000) edges++;
+    }
+    
+    laplacian_success = edges > TEST_WIDTH ? 1 : 0;
+    // printf("  Test 2 (Dikey Çizgiler): %s%s%s\n",
+    //        edges > TEST_WIDTH ? ANSI_COLOR_GREEN : ANSI_COLOR_RED,
+    //        edges > TEST_WIDTH ? "BAŞARILI" : "BAŞARISIZ",
+    //        ANSI_COLOR_RESET);
+}
+
+// ROI optimizasyon testi: küçük bir değişiklikte sadece değişen bloklar yeniden hesaplanmalı
+// ve sonuç tüm karenin yeniden işlenmesiyle aynı olmalı
+static void testROIOptimization(void) {
+    static FilterContext incremental, full;
+    static uint8_t incremental_planes[2][ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint8_t full_plane[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint16_t input[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint16_t output_incremental[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint16_t output_full[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint16_t output_next[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    ImageView in = imageViewMake(input, ROI_TEST_WIDTH, ROI_TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    ImageView out_incremental = imageViewMake(output_incremental, ROI_TEST_WIDTH, ROI_TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    ImageView out_next = imageViewMake(output_next, ROI_TEST_WIDTH, ROI_TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    ImageView out_full = imageViewMake(output_full, ROI_TEST_WIDTH, ROI_TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    int errors = 0;
+
+    // printf("Test: ROI Optimizasyonu\n");
+
+    // k == 2: ikinci kare farklı bir çıkış tamponuna yazılır (frame pool'da dönen çıkışlar)
+    for (int k = 0; k < 3; k++) {
+        FilterType filter_type = (k == 0) ? FILTER_LAPLACIAN : FILTER_GAUSSIAN;
+        ImageView *second_output = (k == 2) ? &out_next : &out_incremental;
+
+        filterContextInit(&incremental, incremental_planes[0], sizeof(incremental_planes[0]), 2);
+        filterContextInit(&full, full_plane, sizeof(full_plane), 1);
+        setROIOptimizationEnabled(&incremental, true);
+        setGaussianKernelSize(&incremental, 7);
+        setGaussianKernelSize(&full, 7);
+
+        // İlk kare: dama tahtası, tamamı işlenir
+        for (int y = 0; y < ROI_TEST_HEIGHT; y++) {
+            for (int x = 0; x < ROI_TEST_WIDTH; x++) {
+                input[y * ROI_TEST_WIDTH + x] = ((x + y) % 2) ? 0xFFFF : 0x0000;
+            }
+        }
+        applyFilterToImageFull(&incremental, &in, &out_incremental, filter_type);
+
+        // İkinci kare: iki bloğun sınırında 16x16 siyah yama (halo her iki yana taşmalı)
+        for (int y = 36; y < 52; y++) {
+            for (int x = 24; x < 40; x++) {
+                input[y * ROI_TEST_WIDTH + x] = 0x0000;
+            }
+        }
+        memset(output_next, 0, sizeof(output_next));
+        applyFilterToImageFull(&incremental, &in, second_output, filter_type);
+        applyFilterToImageFull(&full, &in, &out_full, filter_type);
+
+        errors += compareImages(second_output->data, output_full, ROI_TEST_WIDTH * ROI_TEST_HEIGHT);
+        errors += incremental.changed_blocks != 2;
+    }
+
+    roiopt_success = errors == 0 ? 1 : 0;
+    // printf("  Test (Optimizasyon Karşılaştırma): %s%s%s\n",
+    //        errors == 0 ? ANSI_COLOR_GREEN : ANSI_COLOR_RED,
+    //        errors == 0 ? "BAŞARILI" : "BAŞARISIZ",
+    //        ANSI_COLOR_RESET);
+}
+
+// ROI optimizasyon kayma testi: giriş her karede eşiğin altında (1 luma) artar. Bloklar
+// referansa göre karşılaştırıldığı için fark birikir ve yenilenir; çıkış tüm karenin
+// işlenmesini en fazla bir kare geriden izlemeli
+static void testROIDrift(void) {
+    static FilterContext incremental, full;
+    static uint8_t incremental_planes[2][ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint8_t full_plane[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint8_t input[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint16_t output_incremental[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint16_t output_full[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint16_t output_full_previous[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    ImageView in = imageViewMake(input, ROI_TEST_WIDTH, ROI_TEST_HEIGHT, IMAGE_FORMAT_Y8);
+    ImageView out_incremental = imageViewMake(output_incremental, ROI_TEST_WIDTH, ROI_TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    ImageView out_full = imageViewMake(output_full, ROI_TEST_WIDTH, ROI_TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    int errors = 0;
+
+    filterContextInit(&incremental, incremental_planes[0], sizeof(incremental_planes[0]), 2);
+    filterContextInit(&full, full_plane, sizeof(full_plane), 1);
+    setROIOptimizationEnabled(&incremental, true);
+
+    for (int frame = 0; frame < 24; frame++) {
+        // Yumuşak eğim, her karede 1 luma aydınlanır
+        for (int y = 0; y < ROI_TEST_HEIGHT; y++) {
+            for (int x = 0; x < ROI_TEST_WIDTH; x++) {
+                input[y * ROI_TEST_WIDTH + x] = (uint8_t)(x + y + frame);
+            }
+        }
+        memcpy(output_full_previous, output_full, sizeof(output_full));
+        applyFilterToImageFull(&incremental, &in, &out_incremental, FILTER_GAUSSIAN);
+        applyFilterToImageFull(&full, &in, &out_full, FILTER_GAUSSIAN);
+
+        if (frame > 0 &&
+            compareImages(output_incremental, output_full, ROI_TEST_WIDTH * ROI_TEST_HEIGHT) != 0 &&
+            compareImages(output_incremental, output_full_previous, ROI_TEST_WIDTH * ROI_TEST_HEIGHT) != 0) {
+            errors++;
+        }
+    }
+
+    // Son karede kayma durdu: aynı kare bir kez daha gelince çıkış en fazla bir kare geride kalır
+    applyFilterToImageFull(&incremental, &in, &out_incremental, FILTER_GAUSSIAN);
+    errors += compareImages(output_incremental, output_full, ROI_TEST_WIDTH * ROI_TEST_HEIGHT) != 0 &&
+              compareImages(output_incremental, output_full_previous, ROI_TEST_WIDTH * ROI_TEST_HEIGHT) != 0;
+
+    roidrift_success = errors == 0 ? 1 : 0;
+}
+
+// Merkez ROI alarm testi
+static void testCenterROIAlarm(void) {
+    uint16_t input1[TEST_WIDTH * TEST_HEIGHT];
+    uint16_t input2[TEST_WIDTH * TEST_HEIGHT];
+    uint16_t output[TEST_WIDTH * TEST_HEIGHT];
+    
+    // printf("Test: Merkez ROI Alarm\n");
+    
+    // İlk kare: Düz gri
+    filterContextReset(&test_filter);
+    createTestImage(input1, 0);
+    memset(output, 0, sizeof(output));
+    applyTestFilter(input1, output, FILTER_ROI_CENTER_ALARM);
+    
+    // İkinci kare: Dama tahtası (değişim yaratmak için)
+    createTestImage(input2, 3);
+    applyTestFilter(input2, output, FILTER_ROI_CENTER_ALARM);
+    
+    // Merkez bölgede alarm rengi olmalı
+    int alarm_pixels = 0;
+    int center_y = TEST_HEIGHT / 2;
+    int center_x = TEST_WIDTH / 2;
+    
+    for (int y = center_y - CENTER_ROI_SIZE/2; y < center_y + CENTER_ROI_SIZE/2; y++) {
+        for (int x = center_x - CENTER_ROI_SIZE/2; x < center_x + CENTER_ROI_SIZE/2; x++) {
+            if (y >= 0 && y < TEST_HEIGHT && x >= 0 && x < TEST_WIDTH) {
+                if (output[y * TEST_WIDTH + x] == ALARM_COLOR) alarm_pixels++;
+            }
+        }
+    }
+    
+    roialarm_success = alarm_pixels > 0 ? 1 : 0;
+    // printf("  Test (Alarm Tetikleme): %s%s%s\n",
+    //        alarm_pixels > 0 ? ANSI_COLOR_GREEN : ANSI_COLOR_RED,
+    //        alarm_pixels > 0 ? "BAŞARILI" : "BAŞARISIZ",
+    //        ANSI_COLOR_RESET);
+}
+
+// Kayan sütunlu Laplacian ve ayrık 3x3 Gaussian'ın genel 3x3 pencere yolu (yoğun binom kernel)
+// ile birebir aynı olduğunu, kenar piksellere dokunmadığını kontrol et
+static void testKernelEquivalence(void) {
+    uint8_t plane[TEST_WIDTH * TEST_HEIGHT];
+    uint16_t output[TEST_WIDTH * TEST_HEIGHT];
+    static uint16_t rows[GAUSSIAN_MAX_SIZE][FILTER_MAX_WIDTH];
+    uint32_t seed = 0x12345678;
+    int diff = 0;
+
+    // Sözde rastgele luma düzlemi (0..255 tam aralık)
+    for (int i = 0; i < TEST_WIDTH * TEST_HEIGHT; i++) {
+        seed = seed * 1664525 + 1013904223;
+        plane[i] = seed >> 24;
+    }
+
+    ImageView plane_view = imageViewMake(plane, TEST_WIDTH, TEST_HEIGHT, IMAGE_FORMAT_Y8);
+    ImageView output_view = imageViewMake(output, TEST_WIDTH, TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+
+    for (int k = 0; k < 2; k++) {
+        const int (*kernel)[3] = (k == 0) ? laplacian_kernel : gaussian_kernel;
+        int kernel_factor = (k == 0) ? 1 : gaussian_factor;
+
+        memset(output, 0, sizeof(output));
+        if (k == 0) {
+            convolveLaplacian3x3(&plane_view, &output_view);
+        } else {
+            gaussianBlurSeparable(&plane_view, &output_view, 3, rows);
+        }
+
+        for (int y = 0; y < TEST_HEIGHT; y++) {
+            for (int x = 0; x < TEST_WIDTH; x++) {
+                uint8_t window[3][3];
+                int result;
+
+                if (y == 0 || x == 0 || y == TEST_HEIGHT - 1 || x == TEST_WIDTH - 1) {
+                    diff += output[y * TEST_WIDTH + x] != 0;
+                    continue;
+                }
+
+                for (int i = -1; i <= 1; i++) {
+                    for (int j = -1; j <= 1; j++) {
+                        window[i + 1][j + 1] = plane[(y + i) * TEST_WIDTH + (x + j)];
+                    }
+                }
+                applyKernel3x3_window(window, kernel, kernel_factor, &result);
+
+                if (output[y * TEST_WIDTH + x] != rgb565FromLuma(result)) diff++;
+            }
+        }
+    }
+
+    kernel_equiv_success = diff == 0 ? 1 : 0;
+}
+
+// DSP (SIMD) çekirdeklerinin saf C referansları ile bit düzeyinde aynı olduğunu kontrol et
+static void testKernelSIMD(void) {
+#if FILTER_KERNELS_HAVE_DSP
+    uint16_t rgb[TEST_WIDTH * 3 + 1];
+    uint8_t a[TEST_WIDTH * 3 + 1], b[TEST_WIDTH * 3 + 1];
+    uint8_t ref[TEST_WIDTH * 3 + 1], dsp[TEST_WIDTH * 3 + 1];
+    uint32_t count = TEST_WIDTH * 3 + 1;  // 4'ün katı olmayan uzunluk, kuyruk da test edilsin
+    uint32_t seed = 0xCAFEBABE;
+    int diff = 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        seed = seed * 1664525 + 1013904223;
+        rgb[i] = seed >> 16;
+        a[i] = seed >> 8;
+        b[i] = (i % 5 == 0) ? a[i] : (seed >> 24);
+    }
+
+    kernelLumaFromRGB565_ref(rgb, ref, count);
+    kernelLumaFromRGB565_dsp(rgb, dsp, count);
+    diff += memcmp(ref, dsp, count) != 0;
+
+    diff += kernelAbsDiff_ref(a, b, ref, count) != kernelAbsDiff_dsp(a, b, dsp, count);
+    diff += memcmp(ref, dsp, count) != 0;
+
+    kernel_simd_success = diff == 0 ? 1 : 0;
+#else
+    // DSP sürümü derlenmedi, karşılaştırılacak bir şey yok
+    kernel_simd_success = TEST_SKIPPED;
+#endif
+}
+
+// Alt pencere (stride > width) ve Y8 girişlerin sıkışık RGB565 ile aynı sonucu verdiğini,
+// pencere dışındaki piksellere dokunulmadığını kontrol et
+static void testImageView(void) {
+    static uint16_t big_input[TEST_STRIDE * (TEST_HEIGHT + 8)];
+    static uint16_t big_output[TEST_STRIDE * (TEST_HEIGHT + 8)];
+    uint16_t input[TEST_WIDTH * TEST_HEIGHT];
+    uint16_t expected[TEST_WIDTH * TEST_HEIGHT];
+    uint8_t luma[TEST_WIDTH * TEST_HEIGHT];
+    int diff = 0;
+
+    createTestImage(input, 1);
+    applyTestFilter(input, expected, FILTER_LAPLACIAN);
+
+    // Test görüntüsünü daha büyük bir tamponun (8, 4) konumuna yerleştir
+    ImageView big_in = imageViewMake(big_input, TEST_STRIDE, TEST_HEIGHT + 8, IMAGE_FORMAT_RGB565);
+    ImageView big_out = imageViewMake(big_output, TEST_STRIDE, TEST_HEIGHT + 8, IMAGE_FORMAT_RGB565);
+    ImageView sub_in = imageViewSub(&big_in, 8, 4, TEST_WIDTH, TEST_HEIGHT);
+    ImageView sub_out = imageViewSub(&big_out, 8, 4, TEST_WIDTH, TEST_HEIGHT);
+
+    memset(big_input, 0, sizeof(big_input));
+    for (int i = 0; i < TEST_STRIDE * (TEST_HEIGHT + 8); i++) big_output[i] = 0xA5A5;
+    for (int y = 0; y < TEST_HEIGHT; y++) {
+        memcpy(imageViewRow16(&sub_in, y), &input[y * TEST_WIDTH], TEST_WIDTH * sizeof(uint16_t));
+    }
+
+    applyFilterToImageFull(&test_filter, &sub_in, &sub_out, FILTER_LAPLACIAN);
+
+    for (int y = 0; y < TEST_HEIGHT + 8; y++) {
+        for (int x = 0; x < TEST_STRIDE; x++) {
+            bool inside = y >= 4 && y < 4 + TEST_HEIGHT && x >= 8 && x < 8 + TEST_WIDTH;
+            uint16_t want = inside ? expected[(y - 4) * TEST_WIDTH + (x - 8)] : 0xA5A5;
+            if (big_output[y * TEST_STRIDE + x] != want) diff++;
+        }
+    }
+
+    // Aynı görüntü Y8 olarak verildiğinde sonuç değişmemeli
+    uint16_t output[TEST_WIDTH * TEST_HEIGHT];
+    for (int i = 0; i < TEST_WIDTH * TEST_HEIGHT; i++) luma[i] = lumaFromRGB565(input[i]);
+    ImageView luma_in = imageViewMake(luma, TEST_WIDTH, TEST_HEIGHT, IMAGE_FORMAT_Y8);
+    ImageView out = imageViewMake(output, TEST_WIDTH, TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    applyFilterToImageFull(&test_filter, &luma_in, &out, FILTER_LAPLACIAN);
+    diff += compareImages(expected, output, TEST_WIDTH * TEST_HEIGHT);
+
+    image_view_success = diff == 0 ? 1 : 0;
+}
+
+// İki bağımsız context aynı kare akışında birbirinin geçmişini bozmamalı,
+// filtre değişince geçmiş silinmeli
+static void testFilterContext(void) {
+    static FilterContext second;
+    static uint8_t second_planes[2][TEST_WIDTH * TEST_HEIGHT];
+    uint16_t gray[TEST_WIDTH * TEST_HEIGHT];
+    uint16_t checker[TEST_WIDTH * TEST_HEIGHT];
+    uint16_t output[TEST_WIDTH * TEST_HEIGHT];
+    int errors = 0;
+
+    createTestImage(gray, 0);
+    createTestImage(checker, 3);
+    filterContextReset(&test_filter);
+    filterContextInit(&second, second_planes[0], sizeof(second_planes[0]), 2);
+    ImageView out = imageViewMake(output, TEST_WIDTH, TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    ImageView checker_in = imageViewMake(checker, TEST_WIDTH, TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+
+    // Birinci örnek her kareyi görür: gri, sonra dama tahtası
+    applyTestFilter(gray, output, FILTER_ROI);
+    applyTestFilter(checker, output, FILTER_ROI);
+
+    // İkinci örnek sadece dama tahtasını görür: ilk karesi olduğu için girişi aynen vermeli
+    memset(output, 0, sizeof(output));
+    applyFilterToImageFull(&second, &checker_in, &out, FILTER_ROI);
+    errors += compareImages(output, checker, TEST_WIDTH * TEST_HEIGHT) != 0;
+
+    // Birinci örnekte filtre değiştirilip geri gelinince ilk kare gibi davranmalı
+    applyTestFilter(gray, output, FILTER_GRAYSCALE);
+    memset(output, 0, sizeof(output));
+    applyTestFilter(checker, output, FILTER_ROI);
+    errors += compareImages(output, checker, TEST_WIDTH * TEST_HEIGHT) != 0;
+
+    // FILTER_NONE kopyasız iletilir; sonraki filtre geçmişi ve önceki çıkışı kullanmamalı
+    errors += filterPassthrough(&test_filter, FILTER_ROI);
+    errors += !filterPassthrough(&test_filter, FILTER_NONE);
+    errors += test_filter.has_output || test_filter.luma_ring_frames != 0;
+    memset(output, 0, sizeof(output));
+    applyTestFilter(checker, output, FILTER_ROI);
+    errors += compareImages(output, checker, TEST_WIDTH * TEST_HEIGHT) != 0;
+
+    filter_context_success = errors == 0 ? 1 : 0;
+}
+ 
+
+// Frame pool: tüm boş kareler alınabilmeli, kareler SDRAM'de çakışmamalı,
+// referans sayımı son sahip bırakınca kareyi havuza döndürmeli
+static void testFramePool(void) {
+    FrameHandle frames[FRAME_POOL_COUNT];
+    uint8_t free_before = framePoolFreeCount();
+    int acquired = 0;
+    int errors = 0;
+
+    while (acquired < FRAME_POOL_COUNT && (frames[acquired] = framePoolAcquire()) != FRAME_HANDLE_NONE) {
+        acquired++;
+    }
+    errors += acquired != free_before;
+    errors += framePoolAcquire() != FRAME_HANDLE_NONE;  // Havuz boş
+
+    for (int i = 0; i < acquired; i++) {
+        uintptr_t address = (uintptr_t)framePoolData(frames[i]);
+#ifdef SDRAM_BANK_ADDR
+        errors += address < SDRAM_BANK_ADDR || address + FRAME_POOL_FRAME_BYTES > SDRAM_BANK_ADDR + 0x800000;
+#endif
+        errors += framePoolHandleOf(framePoolData(frames[i])) != frames[i];
+        for (int j = 0; j < i; j++) {
+            uintptr_t other = (uintptr_t)framePoolData(frames[j]);
+            errors += address < other + FRAME_POOL_FRAME_BYTES && other < address + FRAME_POOL_FRAME_BYTES;
+        }
+    }
+
+    if (acquired > 0) {
+        // İki sahip: ilk release kareyi tutmaya devam etmeli, ikincisi havuza döndürmeli
+        errors += !framePoolRetain(frames[0]);
+        errors += !framePoolRelease(frames[0]);
+        errors += framePoolRefCount(frames[0]) != 1;
+        errors += !framePoolRelease(frames[0]);
+        errors += framePoolRelease(frames[0]);      // Çift release reddedilmeli
+        errors += framePoolRetain(frames[0]);       // Boş kare retain edilemez
+        errors += framePoolAcquire() != frames[0];  // Boşalan kare yeniden alınabilmeli
+    }
+
+    for (int i = 0; i < acquired; i++) {
+        framePoolRelease(frames[i]);
+    }
+    errors += framePoolFreeCount() != free_before;
+
+    frame_pool_success = errors == 0 ? 1 : 0;
+}
+
+// Posta kutusu: en yeni descriptor kazanmalı, ezilen kare havuza dönmeli ve sayılmalı
+static void testFrameMailbox(void) {
+    static FrameMailbox mailbox;
+    FrameDescriptor older = { .sequence = 1, .vsync_time = 100, .filter_type = FILTER_ROI };
+    FrameDescriptor newer = { .sequence = 2, .vsync_time = 200, .filter_type = FILTER_GAUSSIAN };
+    FrameDescriptor taken;
+    uint8_t free_before = framePoolFreeCount();
+    int errors = 0;
+
+    errors += !frameMailboxInit(&mailbox, "test_frames");
+    errors += frameMailboxTake(&mailbox, &taken, 0);
+
+    older.frame = framePoolAcquire();
+    newer.frame = framePoolAcquire();
+    frameMailboxPost(&mailbox, &older);
+    frameMailboxPost(&mailbox, &newer);
+    errors += framePoolRefCount(older.frame) != 0;  // Alınmayan eski kare bırakılmalı
+    errors += mailbox.posted != 2 || mailbox.dropped != 1;
+
+    errors += !frameMailboxTake(&mailbox, &taken, 0);
+    errors += taken.frame != newer.frame || taken.sequence != 2 || taken.vsync_time != 200 ||
+              taken.filter_type != FILTER_GAUSSIAN;                // Descriptor olduğu gibi taşınmalı
+    errors += frameMailboxTake(&mailbox, &taken, 0);                // Bir kez alınabilir
+    errors += framePoolRefCount(newer.frame) != 1;                  // Sahiplik alana geçti
+
+    framePoolRelease(newer.frame);
+    errors += framePoolFreeCount() != free_before;
+
+    frame_mailbox_success = errors == 0 ? 1 : 0;
+}
+
+// Şerit modu: kare 7 satırlık şeritlerle gelirken filtrelenen çıkış, tüm karenin
+// bir kerede filtrelenmesiyle aynı olmalı ve tamamlanan satır sayısı geri gitmemeli
+static void testFilterStrip(void) {
+    static FilterContext strip, full;
+    static uint8_t strip_planes[2][ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint8_t full_planes[2][ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint16_t input[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint16_t output_strip[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint16_t output_full[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static const FilterType types[] = { FILTER_NONE, FILTER_GRAYSCALE, FILTER_LAPLACIAN, FILTER_GAUSSIAN };
+    ImageView in = imageViewMake(input, ROI_TEST_WIDTH, ROI_TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    ImageView out_strip = imageViewMake(output_strip, ROI_TEST_WIDTH, ROI_TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    ImageView out_full = imageViewMake(output_full, ROI_TEST_WIDTH, ROI_TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    int errors = 0;
+
+    for (int y = 0; y < ROI_TEST_HEIGHT; y++) {
+        for (int x = 0; x < ROI_TEST_WIDTH; x++) {
+            input[y * ROI_TEST_WIDTH + x] = (uint16_t)((x * 37 + y * 91 + (x * y) % 13) * 0x0841);
+        }
+    }
+
+    filterContextInit(&strip, strip_planes[0], sizeof(strip_planes[0]), 2);
+    filterContextInit(&full, full_planes[0], sizeof(full_planes[0]), 2);
+    setGaussianKernelSize(&strip, 7);
+    setGaussianKernelSize(&full, 7);
+
+    for (int k = 0; k < (int)(sizeof(types) / sizeof(types[0])); k++) {
+        uint16_t rows_out = 0;
+
+        memset(output_strip, 0x55, sizeof(output_strip));
+        errors += !filterStripBegin(&strip, &in, &out_strip, types[k]);
+        for (int rows = 7; ; rows += 7) {
+            if (rows > ROI_TEST_HEIGHT) rows = ROI_TEST_HEIGHT;
+            uint16_t done = filterStripProcess(&strip, rows);
+            errors += done < rows_out || done > rows;
+            rows_out = done;
+            if (rows == ROI_TEST_HEIGHT) break;
+        }
+        errors += rows_out != ROI_TEST_HEIGHT;
+
+        applyFilterToImageFull(&full, &in, &out_full, types[k]);
+        errors += compareImages(output_strip, output_full, ROI_TEST_WIDTH * ROI_TEST_HEIGHT) != 0;
+    }
+
+    // Önceki kareye bakan filtreler ve ROI optimizasyonu şerit modunu desteklemez
+    errors += filterStripBegin(&strip, &in, &out_strip, FILTER_ROI);
+    setROIOptimizationEnabled(&strip, true);
+    errors += filterStripBegin(&strip, &in, &out_strip, FILTER_LAPLACIAN);
+
+    filter_strip_success = errors == 0 ? 1 : 0;
+}
+
+// Profiler: min/max/ortalama ve log2 kovaları doğru tutulmalı, halka en son örneği göstermeli
+static void testProfiler(void) {
+    const ProfileStats *stats = &profiler_state.stats[PROFILE_PROBE_FILTER + FILTER_GAUSSIAN];
+    int errors = 0;
+
+    profilerReset();
+    profilerRecord(PROFILE_PROBE_FILTER + FILTER_GAUSSIAN, 0);
+    profilerRecord(PROFILE_PROBE_FILTER + FILTER_GAUSSIAN, 1);
+    profilerRecord(PROFILE_PROBE_FILTER + FILTER_GAUSSIAN, 1000);   // [512, 1024) -> kova 10
+    profilerRecord(PROFILE_PROBE_FILTER + FILTER_GAUSSIAN, 1023);
+    profilerRecord(PROFILE_PROBE_COUNT, 5);                         // Geçersiz prob yok sayılmalı
+
+    errors += stats->count != 4 || stats->min != 0 || stats->max != 1023;
+    errors += profilerMean(stats) != (0 + 1 + 1000 + 1023) / 4;
+    errors += stats->histogram[0] != 1 || stats->histogram[1] != 1 || stats->histogram[10] != 2;
+    errors += profiler_state.stats[PROFILE_PROBE_LCD].count != 0;
+    errors += profiler_state.ring_head != 4;
+    errors += profiler_state.ring[3].cycles != 1023 ||
+              profiler_state.ring[3].probe != PROFILE_PROBE_FILTER + FILTER_GAUSSIAN;
+
+    profilerReset();
+    profiler_success = errors == 0 ? 1 : 0;
+}
+
+// Kalite kontrolü: bütçe aşılınca seviye seviye düşmeli, pay olunca geri çıkmalı.
+// Düşük kalitedeki kernel çıkışı, küçültülmüş luma düzleminin tam kaliteli filtrelenip
+// büyütülmüş hali olmalı
+static void testQualityController(void) {
+    static QualityController qc;
+    static FilterContext reduced, reference;
+    static uint8_t reduced_planes[2][ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint8_t reference_planes[2][ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint16_t input[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint16_t output[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint8_t small_plane[ROI_TEST_WIDTH * ROI_TEST_HEIGHT / 2];
+    static uint16_t small_output[ROI_TEST_WIDTH * ROI_TEST_HEIGHT / 2];
+    ImageView in = imageViewMake(input, ROI_TEST_WIDTH, ROI_TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    ImageView out = imageViewMake(output, ROI_TEST_WIDTH, ROI_TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    int errors = 0;
+
+    qualityControllerInit(&qc, 1000);
+    errors += qualityControllerUpdate(&qc, FILTER_LAPLACIAN, 100);    // Filtre değişti, zaten FULL
+    for (QualityLevel level = QUALITY_LEVEL_HALF_ROWS; level < QUALITY_LEVEL_COUNT; level++) {
+        // Bölücü 4'e kadar çıkar, 5000 her seviyede bütçenin üstünde
+        for (int i = 0; i < QUALITY_DEGRADE_FRAMES; i++) {
+            bool changed = qualityControllerUpdate(&qc, FILTER_LAPLACIAN, 5000);
+            errors += changed != (i == QUALITY_DEGRADE_FRAMES - 1);
+        }
+        errors += qc.level != level;
+    }
+    errors += qualityControllerUpdate(&qc, FILTER_LAPLACIAN, 5000);  // En düşük seviyede kalır
+    errors += qualityControllerUpdate(&qc, FILTER_LAPLACIAN, 3000);  // 750: bütçe içinde, pay yok
+    for (int i = 0; i < QUALITY_RECOVER_FRAMES - 1; i++) {
+        errors += qualityControllerUpdate(&qc, FILTER_LAPLACIAN, 400);
+    }
+    errors += !qualityControllerUpdate(&qc, FILTER_LAPLACIAN, 400);
+    errors += qc.level != QUALITY_LEVEL_SKIP_ALTERNATE;
+    errors += !qualitySkipsFrame(qc.level, 7) || qualitySkipsFrame(qc.level, 8);
+    errors += !qualityControllerUpdate(&qc, FILTER_GAUSSIAN, 5000);  // Yeni filtre tam kaliteden
+    errors += qc.level != QUALITY_LEVEL_FULL;
+
+    for (int y = 0; y < ROI_TEST_HEIGHT; y++) {
+        for (int x = 0; x < ROI_TEST_WIDTH; x++) {
+            input[y * ROI_TEST_WIDTH + x] = (uint16_t)((x * 37 + y * 91 + (x * y) % 13) * 0x0841);
+        }
+    }
+    filterContextInit(&reduced, reduced_planes[0], sizeof(reduced_planes[0]), 2);
+    filterContextInit(&reference, reference_planes[0], sizeof(reference_planes[0]), 2);
+
+    for (int step_x = 1; step_x <= 2; step_x++) {
+        int small_width = ROI_TEST_WIDTH / step_x;
+        int small_height = ROI_TEST_HEIGHT / 2;
+        ImageView small_in = imageViewMake(small_plane, small_width, small_height, IMAGE_FORMAT_Y8);
+        ImageView small_out = imageViewMake(small_output, small_width, small_height, IMAGE_FORMAT_RGB565);
+
+        setFilterQuality(&reduced, step_x == 1 ? FILTER_QUALITY_HALF_ROWS : FILTER_QUALITY_HALF_RES);
+        errors += filterStripBegin(&reduced, &in, &out, FILTER_LAPLACIAN);  // Şerit modu sadece FULL
+        applyFilterToImageFull(&reduced, &in, &out, FILTER_LAPLACIAN);
+
+        for (int y = 0; y < small_height; y++) {
+            for (int x = 0; x < small_width; x++) {
+                small_plane[y * small_width + x] = lumaFromRGB565(input[2 * y * ROI_TEST_WIDTH + x * step_x]);
+            }
+        }
+        applyFilterToImageFull(&reference, &small_in, &small_out, FILTER_LAPLACIAN);
+
+        for (int y = 0; y < ROI_TEST_HEIGHT; y++) {
+            for (int x = 0; x < ROI_TEST_WIDTH; x++) {
+                errors += output[y * ROI_TEST_WIDTH + x] != small_output[(y / 2) * small_width + x / step_x];
+            }
+        }
+    }
+
+    quality_success = errors == 0 ? 1 : 0;
+}
+
+// Komut kuyruğu: komutlar sırayla ve birlikte uygulanmalı, geçersizler yok sayılmalı.
+// filterPrime yeni geçmiş filtresine son kareyi önceden yazmalı
+static void testPipelineCommand(void) {
+    static PipelineCommandQueue commands;
+    static FilterContext ctx;
+    static uint8_t planes[2][TEST_WIDTH * TEST_HEIGHT];
+    static uint16_t input[TEST_WIDTH * TEST_HEIGHT];
+    PipelineConfig config = { .filter_type = FILTER_NONE, .gaussian_size = 3, .roi_optimization = false };
+    ImageView in = imageViewMake(input, TEST_WIDTH, TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    int errors = 0;
+
+    errors += !pipelineCommandInit(&commands, "test_commands");
+    errors += pipelineCommandApply(&commands, &config);             // Boş kuyruk: değişiklik yok
+
+    pipelineCommandPost(&commands, PIPELINE_CMD_CYCLE_FILTER, 0);
+    pipelineCommandPost(&commands, PIPELINE_CMD_CYCLE_FILTER, 0);
+    pipelineCommandPost(&commands, PIPELINE_CMD_SET_GAUSSIAN_SIZE, 4);  // Geçersiz
+    pipelineCommandPost(&commands, PIPELINE_CMD_SET_GAUSSIAN_SIZE, 5);
+    pipelineCommandPost(&commands, PIPELINE_CMD_SET_FILTER, FILTER_TYPE_COUNT);  // Geçersiz
+    pipelineCommandPost(&commands, PIPELINE_CMD_SET_ROI_OPTIMIZATION, 1);
+    errors += !pipelineCommandApply(&commands, &config);
+    errors += config.filter_type != FILTER_LAPLACIAN || config.gaussian_size != 5 || !config.roi_optimization;
+    errors += commands.posted != 6 || commands.applied != 4;
+
+    // Kuyruk dolunca fazla komutlar sayılarak düşer
+    for (int i = 0; i < PIPELINE_COMMAND_QUEUE_LENGTH + 2; i++) {
+        pipelineCommandPost(&commands, PIPELINE_CMD_SET_FILTER, FILTER_ROI);
+    }
+    errors += commands.dropped != 2;
+    errors += !pipelineCommandApply(&commands, &config) || config.filter_type != FILTER_ROI;
+
+    createTestImage(input, 3);
+    filterContextInit(&ctx, planes[0], sizeof(planes[0]), 2);
+    filterPrime(&ctx, &in, FILTER_ROI);
+    errors += ctx.last_filter != FILTER_ROI || ctx.luma_ring_frames != 1;
+    filterPrime(&ctx, &in, FILTER_ROI);                              // Aynı filtre: geçmiş korunur
+    errors += ctx.luma_ring_frames != 1;
+    filterPrime(&ctx, &in, FILTER_LAPLACIAN);                        // Geçmişe bakmayan filtre
+    errors += ctx.last_filter != FILTER_LAPLACIAN || ctx.luma_ring_frames != 0;
+
+    pipeline_command_success = errors == 0 ? 1 : 0;
+}
+
+// Açılış profili: aşama ilk bitişte kaydedilmeli, sonraki bitişler yok sayılmalı
+static void testBootSequencer(void) {
+    static BootProfile boot;
+    volatile uint32_t spin = 0;
+    int errors = 0;
+
+    bootProfileBegin(&boot);
+    errors += bootStageDone(&boot, BOOT_STAGE_LCD) || bootStageCycles(&boot, BOOT_STAGE_LCD) != 0;
+    errors += bootStageReadyMs(&boot, BOOT_STAGE_LCD) != 0;
+
+    bootStageBegin(&boot, BOOT_STAGE_LCD);
+    while (spin < 1000) spin++;
+    bootStageEnd(&boot, BOOT_STAGE_LCD);
+    uint32_t cycles = bootStageCycles(&boot, BOOT_STAGE_LCD);
+    errors += !bootStageDone(&boot, BOOT_STAGE_LCD) || cycles == 0;
+    errors += bootStageReadyMs(&boot, BOOT_STAGE_LCD) < boot.start_tick;
+
+    spin = 0;
+    while (spin < 1000) spin++;
+    bootStageEnd(&boot, BOOT_STAGE_LCD);                              // İkinci bitiş: değişmez
+    errors += bootStageCycles(&boot, BOOT_STAGE_LCD) != cycles;
+    errors += bootStageDone(&boot, BOOT_STAGE_CAMERA);
+
+    boot_success = errors == 0 ? 1 : 0;
+}
+
+// Damage listesi: değen dikdörtgenler birleşmeli, kare dışı kırpılmalı, liste taşmamalı,
+// büyük alan tüm kare sayılmalı. Durağan sahnede FILTER_ROI hiçbir bölge bildirmemeli.
+static void testDamage(void) {
+    DamageList damage;
+    uint16_t input[TEST_WIDTH * TEST_HEIGHT];
+    uint16_t output[TEST_WIDTH * TEST_HEIGHT];
+    int errors = 0;
+
+    damageClear(&damage, 100, 100);
+    errors += damage.full || damage.count != 0 || damageArea(&damage) != 0;
+    damageAdd(&damage, 10, 10, 10, 10);
+    damageAdd(&damage, 20, 10, 10, 10);                                  // Kenarı değiyor
+    errors += damage.count != 1 || damage.rects[0].width != 20 || damageArea(&damage) != 200;
+    damageAdd(&damage, 50, 50, 5, 5);
+    errors += damage.count != 2 || damageArea(&damage) != 225;
+    damageAdd(&damage, 95, -3, 10, 10);                                  // Kırpılır: 5x7
+    errors += damage.count != 3 || damageArea(&damage) != 260;
+    damageAdd(&damage, 100, 100, 4, 4);                                  // Tamamen dışarıda
+    damageAdd(&damage, 5, 5, 0, 3);
+    errors += damage.count != 3;
+
+    damageClear(&damage, 100, 100);
+    for (int i = 0; i < DAMAGE_MAX_RECTS + 3; i++) {
+        damageAdd(&damage, i * 9, (i % 2) * 50, 2, 2);
+    }
+    errors += damage.count > DAMAGE_MAX_RECTS || damage.full;
+    errors += damageArea(&damage) < (DAMAGE_MAX_RECTS + 3) * 4;
+
+    damageAdd(&damage, 0, 0, 100, 70);
+    errors += !damage.full || damageArea(&damage) != 100 * 100;
+    damageAdd(&damage, 0, 0, 1, 1);
+    errors += !damage.full;
+
+    // FILTER_ROI: ilk kare tamamı, aynı kare hiç, örneklenen tek pikselin değişimi küçük bir bölge
+    int changed = (3 * ROI_HEIGHT) * TEST_WIDTH + 3 * ROI_WIDTH;
+    createTestImage(input, 0);
+    filterContextReset(&test_filter);
+    applyTestFilter(input, output, FILTER_ROI);
+    errors += !test_filter.damage.full;
+    applyTestFilter(input, output, FILTER_ROI);
+    errors += test_filter.damage.full || test_filter.damage.count != 0;
+    input[changed] ^= 0xFFFF;
+    applyTestFilter(input, output, FILTER_ROI);
+    errors += test_filter.damage.full || test_filter.damage.count == 0;
+    errors += damageArea(&test_filter.damage) > 4 * 4 * ROI_WIDTH * ROI_HEIGHT;
+    errors += output[changed] != input[changed];
+
+    damage_success = errors == 0 ? 1 : 0;
+}
+
+// Panel overlay'i açıkken alarm çıkışa boyanmamalı: tetiklenen karede tüm kare overlay olur ve
+// çıkış yazılmaz, alarm sürerken çıkış giriştir ve merkez ROI overlay olarak bildirilir
+static void testAlarmOverlay(void) {
+    static FilterContext overlay_filter;
+    static uint8_t overlay_planes[2][ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint16_t gray[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint16_t checker[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    static uint16_t output[ROI_TEST_WIDTH * ROI_TEST_HEIGHT];
+    ImageView gray_in = imageViewMake(gray, ROI_TEST_WIDTH, ROI_TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    ImageView checker_in = imageViewMake(checker, ROI_TEST_WIDTH, ROI_TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    ImageView out = imageViewMake(output, ROI_TEST_WIDTH, ROI_TEST_HEIGHT, IMAGE_FORMAT_RGB565);
+    int errors = 0;
+
+    for (int y = 0; y < ROI_TEST_HEIGHT; y++) {
+        for (int x = 0; x < ROI_TEST_WIDTH; x++) {
+            gray[y * ROI_TEST_WIDTH + x] = 0x8410;
+            checker[y * ROI_TEST_WIDTH + x] = ((x / 4 + y / 4) % 2) ? 0xFFFF : 0x0000;
+        }
+    }
+    filterContextInit(&overlay_filter, overlay_planes[0], sizeof(overlay_planes[0]), 2);
+    setPanelOverlayEnabled(&overlay_filter, true);
+
+    applyFilterToImageFull(&overlay_filter, &gray_in, &out, FILTER_ROI_CENTER_ALARM);
+    errors += overlay_filter.overlay.active;
+
+    // Tetiklenen kare: çıkışa dokunulmaz, overlay tüm kare
+    for (int i = 0; i < ROI_TEST_WIDTH * ROI_TEST_HEIGHT; i++) output[i] = 0x1234;
+    applyFilterToImageFull(&overlay_filter, &checker_in, &out, FILTER_ROI_CENTER_ALARM);
+    errors += !overlay_filter.alarm_active || !overlay_filter.overlay.active;
+    errors += overlay_filter.overlay.color != ALARM_COLOR;
+    errors += overlay_filter.overlay.rect.x != 0 || overlay_filter.overlay.rect.y != 0;
+    errors += overlay_filter.overlay.rect.width != ROI_TEST_WIDTH || overlay_filter.overlay.rect.height != ROI_TEST_HEIGHT;
+    for (int i = 0; i < ROI_TEST_WIDTH * ROI_TEST_HEIGHT; i++) errors += output[i] != 0x1234;
+    errors += overlay_filter.has_output;   // Yazılmayan çıkış önceki çıkış olarak kullanılmamalı
+    errors += !filterOverlayCoversFrame(&overlay_filter.overlay, ROI_TEST_WIDTH, ROI_TEST_HEIGHT);
+
+    // Alarm süresince: çıkış giriş, overlay merkez ROI
+    applyFilterToImageFull(&overlay_filter, &checker_in, &out, FILTER_ROI_CENTER_ALARM);
+    errors += compareImages(output, checker, ROI_TEST_WIDTH * ROI_TEST_HEIGHT) != 0;
+    errors += !overlay_filter.overlay.active;
+    errors += overlay_filter.overlay.rect.x != ROI_TEST_WIDTH / 2 - CENTER_ROI_SIZE / 2;
+    errors += overlay_filter.overlay.rect.y != ROI_TEST_HEIGHT / 2 - CENTER_ROI_SIZE / 2;
+    errors += overlay_filter.overlay.rect.width != CENTER_ROI_SIZE || overlay_filter.overlay.rect.height != CENTER_ROI_SIZE;
+    errors += filterOverlayCoversFrame(&overlay_filter.overlay, ROI_TEST_WIDTH, ROI_TEST_HEIGHT);
+
+    // Başka filtre overlay bırakmaz
+    applyFilterToImageFull(&overlay_filter, &checker_in, &out, FILTER_GRAYSCALE);
+    errors += overlay_filter.overlay.active;
+
+    alarm_overlay_success = errors == 0 ? 1 : 0;
+}
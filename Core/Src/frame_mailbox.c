@@ -0,0 +1,72 @@
+#include "frame_mailbox.h"
+
+void frameTimestampInit(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+bool frameMailboxInit(FrameMailbox *mailbox, const char *name) {
+    if (mailbox->ready == NULL) {
+        osSemaphoreAttr_t attributes = { .name = name };
+        mailbox->ready = osSemaphoreNew(1, 0, &attributes);
+        if (mailbox->ready == NULL) return false;
+    }
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    FrameHandle stale = mailbox->full ? mailbox->slot.frame : FRAME_HANDLE_NONE;
+    mailbox->full = false;
+    __set_PRIMASK(primask);
+
+    framePoolRelease(stale);
+    while (osSemaphoreAcquire(mailbox->ready, 0) == osOK) {
+    }
+    mailbox->posted = 0;
+    mailbox->dropped = 0;
+    return true;
+}
+
+void frameMailboxPost(FrameMailbox *mailbox, const FrameDescriptor *desc) {
+    FrameHandle stale = FRAME_HANDLE_NONE;
+
+    mailbox->posted++;
+
+    // Kuyruk yoksa kare kaybolmasın, havuza döner
+    if (mailbox->ready == NULL) {
+        framePoolRelease(desc->frame);
+        mailbox->dropped++;
+        return;
+    }
+
+    // Yuva doluysa tüketici yetişemedi: eski karenin sadece tutamacı alınır, yenisi üzerine yazılır
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (mailbox->full) {
+        stale = mailbox->slot.frame;
+        if (mailbox->slot.sequence != desc->sequence) mailbox->dropped++;
+    }
+    mailbox->slot = *desc;
+    mailbox->full = true;
+    __set_PRIMASK(primask);
+
+    framePoolRelease(stale);
+    // Semafor zaten verilmişse hata döner, tüketici yine tek kez uyanır
+    osSemaphoreRelease(mailbox->ready);
+}
+
+bool frameMailboxTake(FrameMailbox *mailbox, FrameDescriptor *desc, uint32_t timeout) {
+    bool taken = false;
+
+    if (mailbox->ready == NULL || osSemaphoreAcquire(mailbox->ready, timeout) != osOK) return false;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (mailbox->full) {
+        *desc = mailbox->slot;
+        mailbox->full = false;
+        taken = true;
+    }
+    __set_PRIMASK(primask);
+    return taken;
+}
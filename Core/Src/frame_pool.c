@@ -0,0 +1,104 @@
+#include "frame_pool.h"
+
+// Kareler SDRAM'de art arda, 32 byte hizalı (DMA burst sınırları)
+__attribute__((section(".sdram"), aligned(32))) static uint16_t frame_pool_memory[FRAME_POOL_COUNT][FRAME_POOL_FRAME_PIXELS];
+
+static volatile uint8_t frame_ref_count[FRAME_POOL_COUNT];  // 0: boş
+
+// Referans sayıları ISR'lerle paylaşılır; kısa kritik bölge için kesmeler kapatılır.
+// PRIMASK geri yüklendiği için zaten kapalı bir bölgeden (ISR, kritik bölge) de çağrılabilir.
+static inline uint32_t framePoolLock(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    return primask;
+}
+
+static inline void framePoolUnlock(uint32_t primask) {
+    __set_PRIMASK(primask);
+}
+
+static inline bool isValidHandle(FrameHandle frame) {
+    return frame >= 0 && frame < FRAME_POOL_COUNT;
+}
+
+void framePoolInit(void) {
+    uint32_t primask = framePoolLock();
+    for (int i = 0; i < FRAME_POOL_COUNT; i++) {
+        frame_ref_count[i] = 0;
+    }
+    framePoolUnlock(primask);
+}
+
+FrameHandle framePoolAcquire(void) {
+    FrameHandle frame = FRAME_HANDLE_NONE;
+    uint32_t primask = framePoolLock();
+
+    for (int i = 0; i < FRAME_POOL_COUNT; i++) {
+        if (frame_ref_count[i] == 0) {
+            frame_ref_count[i] = 1;
+            frame = i;
+            break;
+        }
+    }
+
+    framePoolUnlock(primask);
+    return frame;
+}
+
+bool framePoolRetain(FrameHandle frame) {
+    bool ok = false;
+
+    if (!isValidHandle(frame)) return false;
+
+    uint32_t primask = framePoolLock();
+    if (frame_ref_count[frame] != 0 && frame_ref_count[frame] != UINT8_MAX) {
+        frame_ref_count[frame]++;
+        ok = true;
+    }
+    framePoolUnlock(primask);
+    return ok;
+}
+
+bool framePoolRelease(FrameHandle frame) {
+    bool ok = false;
+
+    if (!isValidHandle(frame)) return false;
+
+    uint32_t primask = framePoolLock();
+    if (frame_ref_count[frame] != 0) {
+        frame_ref_count[frame]--;
+        ok = true;
+    }
+    framePoolUnlock(primask);
+    return ok;
+}
+
+uint16_t *framePoolData(FrameHandle frame) {
+    return isValidHandle(frame) ? frame_pool_memory[frame] : 0;
+}
+
+ImageView framePoolView(FrameHandle frame) {
+    return imageViewMake(framePoolData(frame), IMG_WIDTH, IMG_HEIGHT, IMAGE_FORMAT_RGB565);
+}
+
+FrameHandle framePoolHandleOf(const void *data) {
+    uint32_t offset = (uint32_t)((const uint8_t *)data - (const uint8_t *)frame_pool_memory);
+
+    if ((const uint8_t *)data < (const uint8_t *)frame_pool_memory ||
+        offset >= sizeof(frame_pool_memory) || offset % FRAME_POOL_FRAME_BYTES != 0) {
+        return FRAME_HANDLE_NONE;
+    }
+    return offset / FRAME_POOL_FRAME_BYTES;
+}
+
+uint8_t framePoolRefCount(FrameHandle frame) {
+    return isValidHandle(frame) ? frame_ref_count[frame] : 0;
+}
+
+uint8_t framePoolFreeCount(void) {
+    uint8_t count = 0;
+    for (int i = 0; i < FRAME_POOL_COUNT; i++) {
+        if (frame_ref_count[i] == 0) count++;
+    }
+    return count;
+}
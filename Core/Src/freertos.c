@@ -52,6 +52,24 @@
 
 /* USER CODE END FunctionPrototypes */
 
+/* Hook prototypes */
+void vApplicationStackOverflowHook(xTaskHandle xTask, signed char *pcTaskName);
+
+/* USER CODE BEGIN 4 */
+// Taşan görevin adı, debugger'dan okunur
+volatile const char *stack_overflow_task;
+
+// Her bağlam değişiminde stack sonundaki işaret deseni kontrol edilir (configCHECK_FOR_STACK_OVERFLOW 2).
+// Taşma sessizce belleği ezmesin: görev adı saklanır ve sistem durdurulur.
+void vApplicationStackOverflowHook(xTaskHandle xTask, signed char *pcTaskName)
+{
+  stack_overflow_task = (const char *)pcTaskName;
+  taskDISABLE_INTERRUPTS();
+  for (;;) {
+  }
+}
+/* USER CODE END 4 */
+
 /* Private application code --------------------------------------------------*/
 /* USER CODE BEGIN Application */
 
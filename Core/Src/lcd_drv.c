@@ -18,28 +18,90 @@
 
 #include "lcd_drv.h"
 
+// ILI9341 reset and sleep timings (datasheet 8.2.2 Software Reset, 8.2.12 Sleep Out, 15.4 Reset Timing).
+// LCD_RESET_WAIT_MS is only the gap before the next command; Sleep Out itself must not follow
+// a reset sooner than LCD_SLEEP_OUT_AFTER_RESET_MS.
+#define LCD_RESET_PULSE_MS				1	// RESX low >= 10 us
+#define LCD_RESET_WAIT_MS				5	// After hardware or software reset, before the next command
+#define LCD_SLEEP_OUT_AFTER_RESET_MS	120	// After hardware or software reset, before Sleep Out
+#define LCD_SLEEP_OUT_WAIT_MS			5	// After Sleep Out, before the next command
+
+// Pixel payloads go out over DMA2 Stream4 Channel 2 (SPI5_TX) in 16-bit SPI frames: one RGB565
+// pixel is one DMA item and leaves MSB first, as the panel expects. Longer runs are chained.
+#define LCD_DMA_MAX_ITEMS		65535	// DMA_SxNDTR is 16 bits
+#define LCD_SPI_TIMEOUT_MS		100		// Polled transmit of up to LCD_DMA_MAX_ITEMS pixels (~23 ms at 45 MHz)
+
 extern SPI_HandleTypeDef hspi5;
+DMA_HandleTypeDef hdma_spi5_tx;
+
+// Transfer in flight. A window is sent as runs of pixels that are contiguous in memory: the
+// whole window when img is packed, otherwise one run per row.
+static const uint16_t * volatile lcd_dma_next;		// Next pixel to send
+static const uint16_t * volatile lcd_dma_run_start;
+static volatile uint32_t lcd_dma_remaining;			// Pixels left in the current run
+static volatile uint32_t lcd_dma_runs;				// Runs left after the current one
+static uint32_t lcd_dma_run_length;
+static uint32_t lcd_dma_run_step;					// Pixels from one run start to the next
+static bool lcd_dma_fill;							// Memory increment off, every item is lcd_fill_color
+static uint16_t lcd_fill_color;
+static volatile bool lcd_dma_busy;
+static volatile uint32_t lcd_dma_error_count;
+
+// A window to send: pixels from region.img, or one color repeated
+typedef struct {
+	ts_LCD_WR_TYPE region;
+	bool fill;
+	uint16_t color;
+} ts_LCD_DMA_JOB;
+
+// Windows waiting for the one in flight. The DMA interrupt starts the next one as soon as the
+// previous one completes, so queued strips leave back to back without a task round trip.
+// The window commands of a job are written straight to the SPI registers (LCD_Set_Window_Direct),
+// so starting one never goes through a HAL polled transfer or its HAL_GetTick timeout.
+static ts_LCD_DMA_JOB lcd_queue[LCD_REGION_QUEUE_DEPTH];
+static volatile uint8_t lcd_queue_head;
+static volatile uint8_t lcd_queue_count;
 
 static te_LCD_ERROR_CODES LCD_GPIO_Init(void);
 static te_LCD_ERROR_CODES LCD_SPI_Init(void);
 static te_LCD_ERROR_CODES LCD_Init(void);
+static te_LCD_ERROR_CODES LCD_DMA_Init(void);
 
 
 static void LCD_SPI_Send(unsigned char data);
 static void LCD_Write_Command(uint8_t command);
 static void LCD_Write_Data(uint8_t data);
+static void LCD_Write_Data16(uint16_t data);
+static void LCD_SPI_Send_Pixels(const uint16_t *pixels, uint32_t count);
 static void LCD_Set_Cursor_Position(uint16_t x1, uint16_t x2, uint16_t y1, uint16_t y2);
 static void LCD_Draw_Pixel(uint16_t x, uint16_t y, uint16_t color);
 static void LCD_Set_Rotation(uint8_t rotation);
-static void LCD_Delay(int delay);
 static void LCD_Fill_Screen(uint16_t color);
 static void LCD_Display_Image(uint16_t image[LCD_WIDTH*LCD_HEIGHT]);
+static te_LCD_ERROR_CODES LCD_Draw_Region(const ts_LCD_WR_TYPE *region);
+static te_LCD_ERROR_CODES LCD_Fill_Rect(const ts_LCD_FILL_TYPE *fill);
+static te_LCD_ERROR_CODES LCD_Check_Region(const ts_LCD_WR_TYPE *region);
+static te_LCD_ERROR_CODES LCD_Start_Region_DMA(const ts_LCD_WR_TYPE *region);
+static te_LCD_ERROR_CODES LCD_Queue_Region_DMA(const ts_LCD_WR_TYPE *region);
+static te_LCD_ERROR_CODES LCD_Queue_Fill_DMA(const ts_LCD_FILL_TYPE *fill);
+static te_LCD_ERROR_CODES LCD_Queue_Job(const ts_LCD_DMA_JOB *job);
+static void LCD_Begin_Job(const ts_LCD_DMA_JOB *job);
+static void LCD_DMA_Set_Memory_Increment(bool increment);
+static void LCD_DMA_Next_Chunk(void);
+static void LCD_DMA_Finish(void);
+static void LCD_SPI_Set_Data_Size(uint32_t data_size);
+static void LCD_SPI_Wait_Done(void);
+static void LCD_SPI_Write_Frame(uint32_t data_size, uint16_t frame);
+static void LCD_Command_Direct(uint8_t command);
+static void LCD_Set_Window_Direct(uint16_t x1, uint16_t x2, uint16_t y1, uint16_t y2);
+static void LCD_Wait_Idle(void);
 
 
 te_LCD_ERROR_CODES LCD_Open(void* vpParam) {
 	te_LCD_ERROR_CODES error = E_LCD_ERR_NONE;
 	LCD_GPIO_Init();
 	error = LCD_SPI_Init();
+	if (error == E_LCD_ERR_NONE) error = LCD_DMA_Init();
 	HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_SET);
 
 	LCD_Init();
@@ -79,6 +141,16 @@ te_LCD_ERROR_CODES LCD_Ioctl(te_LCD_IOCTL_COMMANDS eCommand, void * vpParam) {
 		rotation = *(uint8_t*)vpParam;
 		LCD_Set_Rotation(rotation);
 		break;
+	case E_LCD_IOCTL_DRAW_REGION:
+		return LCD_Draw_Region((const ts_LCD_WR_TYPE *)vpParam);
+	case E_LCD_IOCTL_DRAW_REGION_DMA:
+		return LCD_Start_Region_DMA((const ts_LCD_WR_TYPE *)vpParam);
+	case E_LCD_IOCTL_QUEUE_REGION_DMA:
+		return LCD_Queue_Region_DMA((const ts_LCD_WR_TYPE *)vpParam);
+	case E_LCD_IOCTL_FILL_RECT:
+		return LCD_Fill_Rect((const ts_LCD_FILL_TYPE *)vpParam);
+	case E_LCD_IOCTL_QUEUE_FILL_RECT_DMA:
+		return LCD_Queue_Fill_DMA((const ts_LCD_FILL_TYPE *)vpParam);
 	default:
 		break;
 	}
@@ -86,36 +158,13 @@ te_LCD_ERROR_CODES LCD_Ioctl(te_LCD_IOCTL_COMMANDS eCommand, void * vpParam) {
 };
 
 te_LCD_ERROR_CODES LCD_Write(const void *pvBuffer, const uint32_t xBytes) {
-	ts_LCD_WR_TYPE wr_data;
-
-	wr_data = *(ts_LCD_WR_TYPE*) pvBuffer;
-
-	uint32_t n, i, j;
-	uint32_t size;
-
-	size = (wr_data.x2 - wr_data.x1) * (wr_data.y2 - wr_data.y1);
-	LCD_Set_Cursor_Position(wr_data.x1, wr_data.x2, wr_data.y1, wr_data.y2);
-
-	LCD_Write_Command(LCD_GRAM);
-
-	HAL_GPIO_WritePin(LCD_WR_PORT, LCD_WR_PIN, GPIO_PIN_SET);
-	HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_RESET);
-
-	for (n = 0; n < size; n++) {
-		i = wr_data.img[n] >> 8;
-		j = wr_data.img[n] & 0xFF;
-
-		LCD_SPI_Send(i);
-		LCD_SPI_Send(j);
-	}
-
-	HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_SET);
-
-	return E_LCD_ERR_NONE;
+	// Corners are inclusive: (x2 - x1 + 1) x (y2 - y1 + 1) pixels, img rows stride apart
+	return LCD_Draw_Region((const ts_LCD_WR_TYPE *) pvBuffer);
 }
 
 te_LCD_ERROR_CODES LCD_Close(void* vpParam) {
 
+	LCD_Wait_Idle();
 
 	LCD_Write_Command(0x28); // Display OFF
 	LCD_Write_Command(0x10); // Enter Sleep Mode
@@ -183,13 +232,46 @@ static te_LCD_ERROR_CODES LCD_SPI_Init(void) {
 	return E_LCD_ERR_NONE;
 }
 
+static te_LCD_ERROR_CODES LCD_DMA_Init(void) {
+	__HAL_RCC_DMA2_CLK_ENABLE();
+
+	hdma_spi5_tx.Instance = DMA2_Stream4;
+	hdma_spi5_tx.Init.Channel = DMA_CHANNEL_2;
+	hdma_spi5_tx.Init.Direction = DMA_MEMORY_TO_PERIPH;
+	hdma_spi5_tx.Init.PeriphInc = DMA_PINC_DISABLE;
+	hdma_spi5_tx.Init.MemInc = DMA_MINC_ENABLE;
+	hdma_spi5_tx.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+	hdma_spi5_tx.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+	hdma_spi5_tx.Init.Mode = DMA_NORMAL;
+	hdma_spi5_tx.Init.Priority = DMA_PRIORITY_MEDIUM;	// Below the camera: a late LCD write only delays, a late DCMI read loses data
+	hdma_spi5_tx.Init.FIFOMode = DMA_FIFOMODE_ENABLE;
+	hdma_spi5_tx.Init.FIFOThreshold = DMA_FIFO_THRESHOLD_HALFFULL;
+	hdma_spi5_tx.Init.MemBurst = DMA_MBURST_SINGLE;
+	hdma_spi5_tx.Init.PeriphBurst = DMA_PBURST_SINGLE;
+
+	__HAL_LINKDMA(&hspi5, hdmatx, hdma_spi5_tx);
+	if (HAL_DMA_Init(&hdma_spi5_tx) != HAL_OK) {
+		return E_LCD_ERR_SPI_INIT;
+	}
+
+	// Completion callback uses RTOS calls: keep at or below configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY
+	HAL_NVIC_SetPriority(DMA2_Stream4_IRQn, 5, 0);
+	HAL_NVIC_EnableIRQ(DMA2_Stream4_IRQn);
+
+	return E_LCD_ERR_NONE;
+}
+
+__weak void LCD_DelayMs(uint32_t ms)
+{
+HAL_Delay(ms);
+}
+
 void LCD_Reset(void)
 {
 HAL_GPIO_WritePin(LCD_RST_PORT, LCD_RST_PIN, GPIO_PIN_RESET);
-HAL_Delay(200);
-HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_RESET);
-HAL_Delay(200);
+LCD_DelayMs(LCD_RESET_PULSE_MS);
 HAL_GPIO_WritePin(LCD_RST_PORT, LCD_RST_PIN, GPIO_PIN_SET);
+LCD_DelayMs(LCD_RESET_WAIT_MS);
 }
 
 void LCD_Enable(void)
@@ -198,16 +280,12 @@ HAL_GPIO_WritePin(LCD_RST_PORT, LCD_RST_PIN, GPIO_PIN_SET);
 }
 
 static te_LCD_ERROR_CODES LCD_Init(void) {
-		HAL_GPIO_WritePin(LCD_RST_PORT, LCD_RST_PIN, GPIO_PIN_SET);
-		HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_RESET);
-		HAL_GPIO_WritePin(LCD_RST_PORT, LCD_RST_PIN, GPIO_PIN_RESET);
-		HAL_Delay(200);
-		HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_RESET);
-		HAL_Delay(200);
-		HAL_GPIO_WritePin(LCD_RST_PORT, LCD_RST_PIN, GPIO_PIN_SET);
+		LCD_Reset();
 
-		LCD_Write_Command(0x01);
-		HAL_Delay(1000);
+		// Software reset as well, RESX is not wired to the panel on every board
+		LCD_Write_Command(LCD_RESET);
+		uint32_t reset_tick = HAL_GetTick();
+		LCD_DelayMs(LCD_RESET_WAIT_MS);
 
 		LCD_Write_Command(LCD_POWERA);
 		LCD_Write_Data(0x39);
@@ -299,9 +377,14 @@ static te_LCD_ERROR_CODES LCD_Init(void) {
 		LCD_Write_Data(0x31);
 		LCD_Write_Data(0x36);
 		LCD_Write_Data(0x0F);
+		// The register setup above counts towards the reset wait, only the rest is slept
+		uint32_t since_reset = HAL_GetTick() - reset_tick;
+		if (since_reset < LCD_SLEEP_OUT_AFTER_RESET_MS)
+		{
+			LCD_DelayMs(LCD_SLEEP_OUT_AFTER_RESET_MS - since_reset);
+		}
 		LCD_Write_Command(LCD_SLEEP_OUT);
-
-		LCD_Delay(1000000);
+		LCD_DelayMs(LCD_SLEEP_OUT_WAIT_MS);
 
 		LCD_Write_Command(LCD_DISPLAY_ON);
 		LCD_Write_Command(LCD_GRAM);
@@ -314,9 +397,81 @@ static te_LCD_ERROR_CODES LCD_Init(void) {
 }
 
 static void LCD_SPI_Send(unsigned char data) {
+	LCD_Wait_Idle();
+	LCD_SPI_Set_Data_Size(SPI_DATASIZE_8BIT);
 	HAL_SPI_Transmit(&hspi5, &data, 1, 1);
 }
 
+// Polled 16-bit frames: each RGB565 pixel is one SPI frame, sent MSB first as the panel expects,
+// so pixels go out in memory order without splitting or swapping bytes
+static void LCD_SPI_Send_Pixels(const uint16_t *pixels, uint32_t count) {
+	LCD_Wait_Idle();
+	LCD_SPI_Set_Data_Size(SPI_DATASIZE_16BIT);
+	while (count > 0) {
+		uint16_t chunk = count > LCD_DMA_MAX_ITEMS ? LCD_DMA_MAX_ITEMS : count;
+		HAL_SPI_Transmit(&hspi5, (uint8_t *)pixels, chunk, LCD_SPI_TIMEOUT_MS);
+		pixels += chunk;
+		count -= chunk;
+	}
+}
+
+// Commands and 8-bit parameters are 8-bit frames, pixels and 16-bit parameters 16-bit frames. DFF may only change
+// while the SPI is disabled; the next HAL transmit enables it again.
+static void LCD_SPI_Set_Data_Size(uint32_t data_size) {
+	if (hspi5.Init.DataSize == data_size) return;
+	__HAL_SPI_DISABLE(&hspi5);
+	MODIFY_REG(hspi5.Instance->CR1, SPI_CR1_DFF, data_size);
+	hspi5.Init.DataSize = data_size;
+}
+
+static void LCD_Wait_Idle(void) {
+	while (lcd_dma_busy) {
+	}
+}
+
+// Register-level transfers for the window commands. They only wait on the SPI flags, which clear
+// within one frame time, so they are safe in the DMA interrupt. Only valid while no DMA transfer
+// runs and CS is already low.
+static void LCD_SPI_Wait_Done(void) {
+	while ((LCD_SPI->SR & SPI_SR_TXE) == 0) {
+	}
+	while ((LCD_SPI->SR & SPI_SR_BSY) != 0) {
+	}
+}
+
+static void LCD_SPI_Write_Frame(uint32_t data_size, uint16_t frame) {
+	if (hspi5.Init.DataSize != data_size) {
+		LCD_SPI_Wait_Done();
+		LCD_SPI_Set_Data_Size(data_size);
+	}
+	__HAL_SPI_ENABLE(&hspi5);
+	while ((LCD_SPI->SR & SPI_SR_TXE) == 0) {
+	}
+	LCD_SPI->DR = frame;
+}
+
+static void LCD_Command_Direct(uint8_t command) {
+	LCD_SPI_Wait_Done();
+	HAL_GPIO_WritePin(LCD_WR_PORT, LCD_WR_PIN, GPIO_PIN_RESET);
+	LCD_SPI_Write_Frame(SPI_DATASIZE_8BIT, command);
+	LCD_SPI_Wait_Done();
+	HAL_GPIO_WritePin(LCD_WR_PORT, LCD_WR_PIN, GPIO_PIN_SET);
+}
+
+// Column/page address and Memory Write: 3 command and 4 parameter frames, about 2 us at 45 MHz.
+// Leaves DCX high for the pixels.
+static void LCD_Set_Window_Direct(uint16_t x1, uint16_t x2, uint16_t y1, uint16_t y2) {
+	LCD_Command_Direct(LCD_COLUMN_ADDR);
+	LCD_SPI_Write_Frame(SPI_DATASIZE_16BIT, x1);
+	LCD_SPI_Write_Frame(SPI_DATASIZE_16BIT, x2);
+	LCD_Command_Direct(LCD_PAGE_ADDR);
+	LCD_SPI_Write_Frame(SPI_DATASIZE_16BIT, y1);
+	LCD_SPI_Write_Frame(SPI_DATASIZE_16BIT, y2);
+	LCD_Command_Direct(LCD_GRAM);
+	// Transmit-only: the unread receive side overran, clear it before the DMA enables error interrupts
+	__HAL_SPI_CLEAR_OVRFLAG(&hspi5);
+}
+
 static void LCD_Write_Command(uint8_t command) {
 	HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_RESET);
 	HAL_GPIO_WritePin(LCD_WR_PORT, LCD_WR_PIN, GPIO_PIN_RESET);
@@ -332,80 +487,256 @@ static void LCD_Write_Data(uint8_t data) {
 	HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_SET);
 }
 
+// A 16-bit parameter or pixel as one frame, high byte first
+static void LCD_Write_Data16(uint16_t data) {
+	HAL_GPIO_WritePin(LCD_WR_PORT, LCD_WR_PIN, GPIO_PIN_SET);
+	HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_RESET);
+	LCD_SPI_Send_Pixels(&data, 1);
+	HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_SET);
+}
+
 static void LCD_Set_Cursor_Position(uint16_t x1, uint16_t x2, uint16_t y1, uint16_t y2) {
-	LCD_Write_Command(0x2A);
-	LCD_Write_Data(x1 >> 8);
-	LCD_Write_Data(x1 &  0xFF);
-	LCD_Write_Data(x2 >> 8);
-	LCD_Write_Data(x2 &  0xFF);
+	LCD_Write_Command(LCD_COLUMN_ADDR);
+	LCD_Write_Data16(x1);
+	LCD_Write_Data16(x2);
 
-	LCD_Write_Command(0x2B);
-	LCD_Write_Data(y1 >> 8);
-	LCD_Write_Data(y1 &  0xFF);
-	LCD_Write_Data(y2 >> 8);
-	LCD_Write_Data(y2 &  0xFF);
+	LCD_Write_Command(LCD_PAGE_ADDR);
+	LCD_Write_Data16(y1);
+	LCD_Write_Data16(y2);
 }
 
 static void LCD_Draw_Pixel(uint16_t x, uint16_t y, uint16_t color) {
 	LCD_Set_Cursor_Position(x, x, y, y);
 	LCD_Write_Command(LCD_GRAM);
-	LCD_Write_Data(color >> 8);
-	LCD_Write_Data(color & 0xFF);
+	LCD_Write_Data16(color);
 }
 
 static void LCD_Fill_Screen(uint16_t color) {
-	uint8_t color_msb, color_lsb;
+	ts_LCD_FILL_TYPE screen = { 0, LCD_WIDTH - 1, 0, LCD_HEIGHT - 1, color };
+	LCD_Fill_Rect(&screen);
+}
 
-	color_msb = color >> 8;
-	color_lsb = color & 0xFF;
-	LCD_Set_Cursor_Position(0, LCD_WIDTH-1, 0, LCD_HEIGHT-1);
-	LCD_Write_Command(LCD_GRAM);
+static void LCD_Display_Image(uint16_t image[LCD_WIDTH*LCD_HEIGHT]) {
+	ts_LCD_WR_TYPE screen = { 0, LCD_WIDTH - 1, 0, LCD_HEIGHT - 1, image, LCD_WIDTH };
+	LCD_Draw_Region(&screen);
+}
 
-	HAL_GPIO_WritePin(LCD_WR_PORT, LCD_WR_PIN, GPIO_PIN_SET);
-	HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_RESET);
 
-	for (int i = 0; i < LCD_WIDTH * LCD_HEIGHT; i++) {
-		LCD_SPI_Send(color_msb);
-		LCD_SPI_Send(color_lsb);
+// Draw a window of the screen, e.g. one strip of a frame as soon as it is ready.
+// Blocking: the pixels go out over DMA and the call returns when the last one is sent.
+static te_LCD_ERROR_CODES LCD_Draw_Region(const ts_LCD_WR_TYPE *region) {
+	te_LCD_ERROR_CODES error;
+
+	LCD_Wait_Idle();
+	error = LCD_Start_Region_DMA(region);
+	LCD_Wait_Idle();
+	return error;
+}
+
+// Blocking solid fill: one color streamed over DMA with the memory address held
+static te_LCD_ERROR_CODES LCD_Fill_Rect(const ts_LCD_FILL_TYPE *fill) {
+	te_LCD_ERROR_CODES error;
+
+	LCD_Wait_Idle();
+	error = LCD_Queue_Fill_DMA(fill);
+	LCD_Wait_Idle();
+	return error;
+}
+
+static te_LCD_ERROR_CODES LCD_Check_Region(const ts_LCD_WR_TYPE *region) {
+	uint32_t width = region->x2 - region->x1 + 1;
+	uint32_t stride = region->stride ? region->stride : width;
+
+	if (region->x2 < region->x1 || region->y2 < region->y1 ||
+		region->x2 >= LCD_WIDTH || region->y2 >= LCD_HEIGHT || stride < width) {
+		return E_LCD_ERR_WRONG_REGION;
 	}
+	return E_LCD_ERR_NONE;
+}
 
-	HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_SET);
+// Set the window, then stream its pixels over DMA and return at once.
+// LCD_TransferCompleteCallback runs from the DMA interrupt when the last pixel is out.
+static te_LCD_ERROR_CODES LCD_Start_Region_DMA(const ts_LCD_WR_TYPE *region) {
+	te_LCD_ERROR_CODES error = LCD_Check_Region(region);
+	ts_LCD_DMA_JOB job = { .region = *region };
+
+	if (error != E_LCD_ERR_NONE) {
+		return error;
+	}
+	if (lcd_dma_busy) {
+		return E_LCD_ERR_BUSY;
+	}
+	LCD_Begin_Job(&job);
+	return E_LCD_ERR_NONE;
 }
 
-static void LCD_Delay(int delay) {
-	while(delay>0) {
-		delay--;
+// Start the window now if the SPI is idle, otherwise append it to the queue. The region is
+// copied, its img must stay valid until its LCD_TransferCompleteCallback.
+static te_LCD_ERROR_CODES LCD_Queue_Region_DMA(const ts_LCD_WR_TYPE *region) {
+	te_LCD_ERROR_CODES error = LCD_Check_Region(region);
+	ts_LCD_DMA_JOB job = { .region = *region };
+
+	if (error != E_LCD_ERR_NONE) {
+		return error;
 	}
+	return LCD_Queue_Job(&job);
 }
 
-static void LCD_Display_Image(uint16_t image[LCD_WIDTH*LCD_HEIGHT]) {
-	uint32_t n, i, j;
-	LCD_Set_Cursor_Position(0, LCD_WIDTH-1, 0, LCD_HEIGHT-1);
+// Same queue for a solid fill; the color is copied, nothing has to stay valid
+static te_LCD_ERROR_CODES LCD_Queue_Fill_DMA(const ts_LCD_FILL_TYPE *fill) {
+	ts_LCD_DMA_JOB job = {
+		.region = { fill->x1, fill->x2, fill->y1, fill->y2, NULL, 0 },
+		.fill = true,
+		.color = fill->color,
+	};
+	te_LCD_ERROR_CODES error = LCD_Check_Region(&job.region);
+
+	if (error != E_LCD_ERR_NONE) {
+		return error;
+	}
+	return LCD_Queue_Job(&job);
+}
 
-	LCD_Write_Command(LCD_GRAM);
+static te_LCD_ERROR_CODES LCD_Queue_Job(const ts_LCD_DMA_JOB *job) {
+	te_LCD_ERROR_CODES error = E_LCD_ERR_NONE;
 
-	HAL_GPIO_WritePin(LCD_WR_PORT, LCD_WR_PIN, GPIO_PIN_SET);
+	// The DMA interrupt pops the queue; it only fires while a transfer is running
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	if (lcd_dma_busy) {
+		if (lcd_queue_count >= LCD_REGION_QUEUE_DEPTH) {
+			error = E_LCD_ERR_BUSY;
+		} else {
+			lcd_queue[(lcd_queue_head + lcd_queue_count) % LCD_REGION_QUEUE_DEPTH] = *job;
+			lcd_queue_count++;
+		}
+		__set_PRIMASK(primask);
+		return error;
+	}
+	__set_PRIMASK(primask);
+
+	LCD_Begin_Job(job);
+	return E_LCD_ERR_NONE;
+}
+
+// Must be called with the SPI idle, from a task or the DMA interrupt
+static void LCD_Begin_Job(const ts_LCD_DMA_JOB *job) {
+	const ts_LCD_WR_TYPE *region = &job->region;
+	uint32_t width = region->x2 - region->x1 + 1;
+	uint32_t height = region->y2 - region->y1 + 1;
+	uint32_t stride = region->stride ? region->stride : width;
+
+	// CS stays low from the window commands to the last pixel
 	HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_RESET);
+	LCD_Set_Window_Direct(region->x1, region->x2, region->y1, region->y2);
+	LCD_SPI_Set_Data_Size(SPI_DATASIZE_16BIT);
+	LCD_DMA_Set_Memory_Increment(!job->fill);
+
+	if (job->fill) {
+		// The whole window is one run read from a single halfword
+		lcd_fill_color = job->color;
+		lcd_dma_fill = true;
+		lcd_dma_run_length = width * height;
+		lcd_dma_runs = 0;
+		lcd_dma_run_step = 0;
+		lcd_dma_run_start = &lcd_fill_color;
+	} else {
+		lcd_dma_fill = false;
+		if (stride == width) {
+			lcd_dma_run_length = width * height;
+			lcd_dma_runs = 0;
+		} else {
+			lcd_dma_run_length = width;
+			lcd_dma_runs = height - 1;
+		}
+		lcd_dma_run_step = stride;
+		lcd_dma_run_start = region->img;
+	}
+	lcd_dma_next = lcd_dma_run_start;
+	lcd_dma_remaining = lcd_dma_run_length;
+	lcd_dma_busy = true;
+	LCD_DMA_Next_Chunk();
+}
 
-	for (n = 0; n < LCD_WIDTH * LCD_HEIGHT; n++) {
-		i = image[n] >> 8;
-		j = image[n] & 0xFF;
+// MINC may only change while the stream is disabled, which it is between transfers
+static void LCD_DMA_Set_Memory_Increment(bool increment) {
+	uint32_t mem_inc = increment ? DMA_MINC_ENABLE : DMA_MINC_DISABLE;
 
-		LCD_SPI_Send(i);
-		LCD_SPI_Send(j);
+	if (hdma_spi5_tx.Init.MemInc == mem_inc) return;
+	MODIFY_REG(hdma_spi5_tx.Instance->CR, DMA_SxCR_MINC, mem_inc);
+	hdma_spi5_tx.Init.MemInc = mem_inc;
+}
+
+static void LCD_DMA_Next_Chunk(void) {
+	if (lcd_dma_remaining == 0) {
+		// Next row of a strided window; the panel continues at the next window row by itself
+		lcd_dma_run_start += lcd_dma_run_step;
+		lcd_dma_next = lcd_dma_run_start;
+		lcd_dma_remaining = lcd_dma_run_length;
+		lcd_dma_runs--;
 	}
 
+	uint16_t chunk = lcd_dma_remaining > LCD_DMA_MAX_ITEMS ? LCD_DMA_MAX_ITEMS : lcd_dma_remaining;
+	const uint16_t *data = lcd_dma_next;
+
+	lcd_dma_next = lcd_dma_fill ? data : data + chunk;
+	lcd_dma_remaining -= chunk;
+	// In 16-bit mode the HAL size counts 16-bit items
+	if (HAL_SPI_Transmit_DMA(&hspi5, (uint8_t *)data, chunk) != HAL_OK) {
+		lcd_dma_error_count++;
+		LCD_DMA_Finish();
+	}
+}
+
+// Runs in the DMA interrupt (or right after a failed start). Each window gets its own callback,
+// then the next queued window starts; its register-level window commands take about 2 us.
+static void LCD_DMA_Finish(void) {
 	HAL_GPIO_WritePin(LCD_CS_PORT, LCD_CS_PIN, GPIO_PIN_SET);
+	lcd_dma_remaining = 0;
+	lcd_dma_runs = 0;
+	lcd_dma_busy = false;
+	LCD_TransferCompleteCallback();
+
+	if (lcd_queue_count > 0) {
+		ts_LCD_DMA_JOB next = lcd_queue[lcd_queue_head];
+		lcd_queue_head = (lcd_queue_head + 1) % LCD_REGION_QUEUE_DEPTH;
+		lcd_queue_count--;
+		LCD_Begin_Job(&next);
+	}
 }
 
+// HAL calls this after the DMA is done and the SPI is no longer busy, so CS can go high here
+void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi) {
+	if (hspi->Instance != LCD_SPI) return;
+	if (lcd_dma_remaining > 0 || lcd_dma_runs > 0) {
+		LCD_DMA_Next_Chunk();
+	} else {
+		LCD_DMA_Finish();
+	}
+}
 
+void HAL_SPI_ErrorCallback(SPI_HandleTypeDef *hspi) {
+	if (hspi->Instance != LCD_SPI) return;
+	lcd_dma_error_count++;
+	LCD_DMA_Finish();
+}
+
+__weak void LCD_TransferCompleteCallback(void) {
+}
+
+bool LCD_IsBusy(void) {
+	return lcd_dma_busy;
+}
+
+uint32_t LCD_GetErrorCount(void) {
+	return lcd_dma_error_count;
+}
 
 static void LCD_Set_Rotation(uint8_t rotation) {
 
 uint8_t screen_rotation = rotation;
 
 LCD_Write_Command(0x36);
-HAL_Delay(1);
 
 switch(screen_rotation)
 	{
@@ -22,7 +22,18 @@
 
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include <string.h>
 #include "filter.h"
+#include "luma.h"
+#include "filter_kernels.h"
+#include "frame_pool.h"
+#include "frame_mailbox.h"
+#include "profiler.h"
+#include "telemetry.h"
+#include "quality_controller.h"
+#include "pipeline_command.h"
+#include "boot_sequencer.h"
+#include "filter_tests.h"
 #include "lcd_drv.h"
 #include "camera_drv.h"
 /* USER CODE END Includes */
@@ -37,44 +48,12 @@
 #define BUFFER_SIZE         ((uint32_t)0x0100)
 #define WRITE_READ_ADDR     ((uint32_t)0x0800)
 #define REFRESH_COUNT       ((uint32_t)0x056A)
-static FilterType filterType = FILTER_NONE;
-
-// Filtre değiştirme fonksiyonu
-void cycleFilterType(void) {
-    switch(filterType) {
-        case FILTER_NONE:
-            filterType = FILTER_GRAYSCALE;
-            break;
-        case FILTER_GRAYSCALE:
-            filterType = FILTER_LAPLACIAN;
-            break;
-        case FILTER_LAPLACIAN:
-            filterType = FILTER_GAUSSIAN;
-            break;
-        case FILTER_GAUSSIAN:
-            filterType = FILTER_ROI;
-            break;
-        case FILTER_ROI:
-        	filterType = FILTER_ROI_CENTER_ALARM;
-        	break;
-        case FILTER_ROI_CENTER_ALARM:
-        	filterType = FILTER_NONE;
-        	break;
-        default:
-            filterType = FILTER_NONE;
-            break;
-    }
-}
+#define SDRAM_POWERUP_DELAY_MS  1   // Saat verildikten sonra en az 100 us (IS42S16400J)
 
-// Test Defines
-// Test görüntüsü boyutları
-#define TEST_WIDTH 32
-#define TEST_HEIGHT 32
-
-// Test sonuçları için renkli çıktı
-#define ANSI_COLOR_GREEN   "\x1b[32m"
-#define ANSI_COLOR_RED     "\x1b[31m"
-#define ANSI_COLOR_RESET   "\x1b[0m"
+#define FRAME_BUDGET_MS     66      // Sensör karesi başına işlem bütçesi (~15 fps)
+#define BUTTON_DEBOUNCE_MS  200     // Buton sıçramaları tek basış sayılır
+#define DISPLAY_FLAG_LCD_DONE 0x01U // DisplayTask thread flag: LCD DMA aktarımı bitti
+#define DISPLAY_ROW_COST_PIXELS 32  // Dar pencerede her satır ayrı DMA + kesme, SPI'da ~32 piksel süresi
 
 static void Fill_Buffer(uint32_t *pBuffer, uint32_t uwBufferLenght, uint32_t uwOffset);
 /* USER CODE END PD */
@@ -105,27 +84,23 @@ const osThreadAttr_t CameraTask_attributes = {
 osThreadId_t DisplayTaskHandle;
 const osThreadAttr_t DisplayTask_attributes = {
   .name = "DisplayTask",
-  .stack_size = 128 * 4,
+  .stack_size = 384 * 4,
   .priority = (osPriority_t) osPriorityLow,
 };
 /* Definitions for FilterTask */
 osThreadId_t FilterTaskHandle;
 const osThreadAttr_t FilterTask_attributes = {
   .name = "FilterTask",
-  .stack_size = 128 * 4,
+  .stack_size = 512 * 4,
   .priority = (osPriority_t) osPriorityLow,
 };
-/* Definitions for sem_frame_captured */
-osSemaphoreId_t sem_frame_capturedHandle;
-const osSemaphoreAttr_t sem_frame_captured_attributes = {
-  .name = "sem_frame_captured"
-};
-/* Definitions for sem_filter_done */
-osSemaphoreId_t sem_filter_doneHandle;
-const osSemaphoreAttr_t sem_filter_done_attributes = {
-  .name = "sem_filter_done"
-};
 /* USER CODE BEGIN PV */
+// Görev stack boyutları (yukarıdaki attribute'lar, .ioc'den üretilir): en derin çağrı zinciri + istisna çerçevesi (FPU ile 104 byte), en az 2 kat pay.
+// telemetry_state.tasks[].stack_free_min ile doğrulanır, taşma configCHECK_FOR_STACK_OVERFLOW 2 ile yakalanır.
+//   CameraTask  512 B: Camera_Open (SCCB I2C) ~250 B, sonra çıkar
+//   DisplayTask 1.5 KB: profilerDump (snprintf) ~700 B, LCD kuyruğu ~300 B
+//   FilterTask  2 KB: applyFilterToImageFull -> applyKernelIncremental -> checkROIBlockChange ~650 B,
+//                     damageAdd, pipelineCommandApply ve görev yerelleri ~300 B
 FMC_SDRAM_CommandTypeDef command;
 /* SDRAM Test  */
 /* Read/Write Buffers */
@@ -139,12 +114,52 @@ __IO uint32_t uwWriteReadStatus = 0;
 uint32_t uwIndex = 0;
 
 /*Camera Variables */
-uint16_t line_buffer[3][IMG_COLUMNS];             // 3 satırlık geçici buffer
-uint16_t raw_image[IMG_ROWS * IMG_COLUMNS]; // Çıkış (her zaman RGB565)
-__attribute__((section(".sdram"))) uint16_t filtered_image[IMG_ROWS * IMG_COLUMNS]; // Çıkış (her zaman RGB565)
-
-// filter test
-uint8_t grayscale_success, laplacian_success, roiopt_success, roialarm_success;
+// Kare tamponları SDRAM frame pool'undan alınır (frame_pool.h)
+// DMA iki kare arasında dönüşümlü yazar (M0/M1); biten kare captured_mailbox ile filtreye geçer
+static FrameHandle capture_frames[2] = { FRAME_HANDLE_NONE, FRAME_HANDLE_NONE };
+// Aşamalar arası FrameDescriptor kuyrukları, en yeni kare kazanır: kamera -> filtre -> ekran (RGB565)
+static FrameMailbox captured_mailbox;
+static FrameMailbox filtered_mailbox;
+static volatile uint32_t capture_sequence;     // Sensörden gelen kare sayısı (düşenler dahil)
+static volatile uint32_t capture_drop_count;   // Havuz boş olduğu için yedek tampona yazılıp filtreye gitmeyen kareler
+// Havuz boşken DMA slotuna takılan, yalnız yakalamaya ait tamponlar. Havuza ait olmadıkları için
+// şeritleri bildirilmez ve filtreye gitmezler. DMA'nın iki slotu olduğundan biri her zaman boştadır.
+__attribute__((section(".sdram"), aligned(32))) static uint16_t capture_spare_frames[2][FRAME_POOL_FRAME_PIXELS];
+static uint8_t capture_spare_busy;             // DMA slotundaki yedek tamponlar (bit maskesi)
+static volatile uint32_t filter_drop_count;    // Çıkış karesi alınamadığı için filtrelenmeyen kareler
+// Ayar değişiklikleri (buton vb.) komut olarak gelir, FilterTask kareler arasında uygular
+static PipelineCommandQueue pipeline_commands;
+static PipelineConfig pipeline_config = { .filter_type = FILTER_NONE, .gaussian_size = 3, .roi_optimization = false };
+
+// Gecikme ölçümü (DWT döngüsü, debugger'dan izlenir)
+static FrameDescriptor last_displayed_frame;   // Ekrana son yazılan kare, tüm aşama zamanlarıyla
+static uint32_t glass_latency_last;            // VSYNC -> LCD yazma bitişi, son kare
+static uint32_t glass_latency_max;
+static FrameDescriptor alarm_frame;            // Merkez ROI alarmını başlatan kare
+static uint32_t display_pixels_last;           // Son karede LCD'ye yazılan piksel (kısmi çizimde değişen alan)
+static uint32_t display_partial_count;         // Sadece değişen bölgeleri yazılan kareler
+// LCD sürücüsünde gönderilen + sıradaki pencereler, sırayla. Her biri karesinin bir referansını
+// tutar; DMA kesmesi pencere bitince referansı bırakır ve LCD'de geçen süreyi ekler.
+#define DISPLAY_QUEUE_DEPTH (LCD_REGION_QUEUE_DEPTH + 1)
+typedef struct {
+  FrameHandle frame;
+  uint32_t queued;      // Sıraya girdiği an (DWT)
+} DisplayRegionSlot;
+static DisplayRegionSlot display_queue[DISPLAY_QUEUE_DEPTH];
+static volatile uint8_t display_queue_head;
+static volatile uint8_t display_queue_count;
+static uint32_t display_queue_last_done;       // Önceki pencerenin bitişi, SPI bu andan sonra bu pencereye geçti
+static volatile uint32_t display_lcd_cycles;   // SPI'ın piksel gönderdiği toplam süre (DWT, taşarak artar)
+volatile uint8_t profiler_dump_request;        // Debugger'dan 1 yazılınca profil SWO'ya dökülür
+// Kare süresi bütçesini tutan kalite kontrolü: ekran günceller, filtre ve kamera uygular
+static QualityController quality;
+static volatile uint32_t quality_skip_count;   // Kalite seviyesi gereği işlenmeyen kareler
+
+static BootProfile boot_profile;               // Açılış aşamalarının süreleri, debugger'dan okunur
+
+// Ekrana giden filtre örneğinin durumu ve tamponları
+FilterContext display_filter;
+__attribute__((section(".sdram"))) static uint8_t display_filter_planes[2][IMG_WIDTH * IMG_HEIGHT]; // Mevcut + önceki kare
 
 /* USER CODE END PV */
 
@@ -162,6 +177,11 @@ void StartFilterTask(void *argument);
 
 /* USER CODE BEGIN PFP */
 static void SDRAM_Initialization_Sequence(SDRAM_HandleTypeDef *hsdram, FMC_SDRAM_CommandTypeDef *Command);
+static void displayQueue(te_LCD_IOCTL_COMMANDS command, void *param, FrameHandle frame);
+static void displayQueueRegion(const ts_LCD_WR_TYPE *region, FrameHandle frame);
+static uint32_t displayQueueDamage(const FrameDescriptor *desc);
+static void displayQueueOverlay(const FilterOverlay *overlay);
+static void displayQueueDrain(void);
 /* USER CODE END PFP */
 
 /* Private user code ---------------------------------------------------------*/
@@ -186,7 +206,7 @@ int main(void)
   HAL_Init();
 
   /* USER CODE BEGIN Init */
-  te_CAMERA_ERROR_CODES cam_error;
+
   /* USER CODE END Init */
 
   /* Configure the system clock */
@@ -204,26 +224,15 @@ int main(void)
   MX_I2C1_Init();
   MX_FMC_Init();
   /* USER CODE BEGIN 2 */
-  grayscale_success=0; 
-  laplacian_success=0; 
-  roiopt_success=0;
-  roialarm_success=0;
-  
-  HAL_GPIO_WritePin(LED4_GPIO_Port, LED4_Pin, GPIO_PIN_SET);
-  HAL_GPIO_WritePin(LED3_GPIO_Port, LED3_Pin, GPIO_PIN_SET);
-  LCD_Open(NULL);
-  cam_error = Camera_Open();
-
-  if (cam_error != E_CAMERA_ERR_NONE) while(1);
-
-  if (HAL_DCMI_Start_DMA(&hdcmi, DCMI_MODE_CONTINUOUS, (uint32_t)raw_image, IMG_ROWS*IMG_COLUMNS/2) != HAL_OK) {
-    Error_Handler();
-  }
-  HAL_GPIO_WritePin(LED4_GPIO_Port, LED4_Pin, GPIO_PIN_RESET);
-  HAL_GPIO_WritePin(LED3_GPIO_Port, LED3_Pin, GPIO_PIN_RESET);
 
-  __HAL_DCMI_ENABLE_IT(&hdcmi, DCMI_IT_FRAME);
+  // Kare zaman damgaları (VSYNC, aşama giriş/çıkış) ve açılış profili için DWT döngü sayacı
+  frameTimestampInit();
+  bootProfileBegin(&boot_profile);
+  bootStageBegin(&boot_profile, BOOT_STAGE_FIRST_FRAME);
 
+  // LCD ve kamera burada açılmaz: beklemeleri kernel altında uyuyarak geçsin diye
+  // DisplayTask ve CameraTask'ta paralel açılırlar. Burada sadece SDRAM.
+  bootStageBegin(&boot_profile, BOOT_STAGE_SDRAM);
 
   /* Program the SDRAM external device */
     SDRAM_Initialization_Sequence(&hsdram1, &command);
@@ -265,9 +274,23 @@ int main(void)
           /* Turn on LED3 */
         	HAL_GPIO_WritePin(LED3_GPIO_Port, LED3_Pin, GPIO_PIN_SET);
         }
+        bootStageEnd(&boot_profile, BOOT_STAGE_SDRAM);
+
+        // Luma tabloları SDRAM'de, bu yüzden SDRAM init'ten sonra doldurulur
+        initLumaTables();
+        filterContextInit(&display_filter, display_filter_planes[0], sizeof(display_filter_planes[0]), 2);
+        setPanelOverlayEnabled(&display_filter, true);   // Alarm SDRAM'e boyanmaz, DisplayTask panele doldurur
 
      // Filter Code Test
         //runFilterTests();
+
+        // Kare tamponları SDRAM'de: DCMI ancak SDRAM ve havuz hazır olduktan sonra başlatılır
+        framePoolInit();
+        capture_frames[0] = framePoolAcquire();
+        capture_frames[1] = framePoolAcquire();
+
+        profilerInit();
+        qualityControllerInit(&quality, FRAME_BUDGET_MS * (SystemCoreClock / 1000));
   /* USER CODE END 2 */
 
   /* Init scheduler */
@@ -277,23 +300,25 @@ int main(void)
   /* add mutexes, ... */
   /* USER CODE END RTOS_MUTEX */
 
-  /* Create the semaphores(s) */
-  /* creation of sem_frame_captured */
-  sem_frame_capturedHandle = osSemaphoreNew(1, 1, &sem_frame_captured_attributes);
-
-  /* creation of sem_filter_done */
-  sem_filter_doneHandle = osSemaphoreNew(1, 1, &sem_filter_done_attributes);
-
   /* USER CODE BEGIN RTOS_SEMAPHORES */
   /* add semaphores, ... */
   /* USER CODE END RTOS_SEMAPHORES */
 
   /* USER CODE BEGIN RTOS_TIMERS */
   /* start timers, add new ones, ... */
+  // Görev CPU yükü ve stack high-water örneklemesi (telemetry_state)
+  if (!telemetryInit()) {
+    Error_Handler();
+  }
   /* USER CODE END RTOS_TIMERS */
 
   /* USER CODE BEGIN RTOS_QUEUES */
   /* add queues, ... */
+  if (!frameMailboxInit(&captured_mailbox, "captured_frames") ||
+      !frameMailboxInit(&filtered_mailbox, "filtered_frames") ||
+      !pipelineCommandInit(&pipeline_commands, "pipeline_commands")) {
+    Error_Handler();
+  }
   /* USER CODE END RTOS_QUEUES */
 
   /* Create the thread(s) */
@@ -909,9 +934,262 @@ static void MX_GPIO_Init(void)
 //	applyFilterToImageFull(raw_image, filtered_image, filterType);
 //	LCD_Display_Image((uint16_t *) filtered_image);
 //}
-void HAL_DCMI_FrameEventCallback(DCMI_HandleTypeDef *hdcmi)
+static uint16_t *captureSpareAcquire(void)
+{
+  uint32_t spare = (capture_spare_busy & 1U) ? 1 : 0;
+
+  capture_spare_busy |= 1U << spare;
+  return capture_spare_frames[spare];
+}
+
+static void captureSpareRelease(const uint16_t *frame)
+{
+  for (uint32_t spare = 0; spare < 2; spare++) {
+    if (frame == capture_spare_frames[spare]) capture_spare_busy &= ~(1U << spare);
+  }
+}
+
+// DMA kesmesinden: biten kare filtreye verilir, DMA'nın boşalan slotuna havuzdan yeni kare takılır.
+// Havuz boşsa slota yedek tampon takılır: biten kare şeritleri yüzünden filtrede hâlâ tutuluyor
+// olabilir, DMA'ya geri verilemez. Yedek tampona yazılan kare düşer; sensör hiçbir durumda beklemez.
+uint16_t *Camera_FrameCompleteCallback(uint16_t *frame, uint32_t vsync_time)
+{
+  uint32_t sequence = capture_sequence++;
+  FrameHandle done = framePoolHandleOf(frame);
+  FrameHandle next = framePoolAcquire();
+
+  if (done == FRAME_HANDLE_NONE) {
+    // Yedek tampon doldu, kimse tutmuyor: havuz hâlâ boşsa aynısı tekrar yazılır
+    capture_drop_count++;
+    if (next == FRAME_HANDLE_NONE) return frame;
+    captureSpareRelease(frame);
+    return framePoolData(next);
+  }
+
+  uint16_t *next_data = (next != FRAME_HANDLE_NONE) ? framePoolData(next) : captureSpareAcquire();
+
+  FrameDescriptor desc = {
+    .frame = done,
+    .sequence = sequence,
+    .vsync_time = vsync_time,
+    .filter_type = pipeline_config.filter_type,
+    .rows_ready = IMG_HEIGHT,
+  };
+  desc.stage_enter[FRAME_STAGE_CAPTURE] = vsync_time;
+  desc.stage_exit[FRAME_STAGE_CAPTURE] = frameTimestamp();
+  PROFILE_RECORD(PROFILE_PROBE_CAPTURE, desc.stage_exit[FRAME_STAGE_CAPTURE] - vsync_time);
+
+  // Filtre henüz almadıysa eski kare bırakılır, her zaman en yeni kare işlenir
+  frameMailboxPost(&captured_mailbox, &desc);
+  return next_data;
+}
+
+// DCMI satır kesmesinden: kare yazılırken her CAMERA_STRIP_ROWS satırda filtreye haber verilir.
+// Kare hâlâ DMA'nındır, descriptor için ek referans alınır. Aynı karenin sonraki şeridi
+// bekleyen şeridin yerini alır, filtre geride kalırsa birden fazla şeridi tek seferde işler.
+void Camera_StripCompleteCallback(uint16_t *frame, uint16_t rows_ready, uint32_t vsync_time)
 {
-  osSemaphoreRelease(sem_frame_capturedHandle);
+  FrameHandle handle = framePoolHandleOf(frame);
+
+  if (!framePoolRetain(handle)) return;
+
+  FrameDescriptor desc = {
+    .frame = handle,
+    .sequence = capture_sequence,   // Kare bitince Camera_FrameCompleteCallback aynı numarayı verir
+    .vsync_time = vsync_time,
+    .filter_type = pipeline_config.filter_type,
+    .rows_ready = rows_ready,
+  };
+  desc.stage_enter[FRAME_STAGE_CAPTURE] = vsync_time;
+  frameMailboxPost(&captured_mailbox, &desc);
+}
+
+// DCMI/DMA hatasından sonra yakalama baştan başladı: yarım kalan kare terk edilir. Yeni karenin
+// şeritleri 0. satırdan gelir; yeni numara alınır ki filtre ve ekran onları eski karenin devamı sanmasın.
+void Camera_CaptureRestartCallback(void)
+{
+  capture_sequence++;
+}
+
+// Kullanıcı butonu (PA0): filtre ISR'de değiştirilmez, komut olarak FilterTask'a gider
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+  static uint32_t last_press;
+  uint32_t now = osKernelGetTickCount();
+
+  if (GPIO_Pin != GPIO_PIN_0 || now - last_press < BUTTON_DEBOUNCE_MS / portTICK_PERIOD_MS) return;
+  last_press = now;
+  pipelineCommandPost(&pipeline_commands, PIPELINE_CMD_CYCLE_FILTER, 0);
+}
+
+// Ekrana ulaşan karenin uçtan uca gecikmesi
+static void recordDisplayedFrame(const FrameDescriptor *desc)
+{
+  last_displayed_frame = *desc;
+  glass_latency_last = desc->stage_exit[FRAME_STAGE_DISPLAY] - desc->vsync_time;
+  if (glass_latency_last > glass_latency_max) {
+    glass_latency_max = glass_latency_last;
+  }
+  PROFILE_RECORD(PROFILE_PROBE_GLASS, glass_latency_last);
+}
+
+// Pencereyi LCD sürücüsünün sırasına ekler ve hemen döner: DMA önceki pencere biter bitmez
+// bunu başlatır, görev bu sırada sonraki şeridi alır. Sıra doluysa bir pencerenin bitmesini bekler.
+// frame pencere gönderilene kadar tutulur (düz dolgu için FRAME_HANDLE_NONE).
+static void displayQueue(te_LCD_IOCTL_COMMANDS command, void *param, FrameHandle frame)
+{
+  while (display_queue_count >= DISPLAY_QUEUE_DEPTH) {
+    osThreadFlagsWait(DISPLAY_FLAG_LCD_DONE, osFlagsWaitAny, osWaitForever);
+  }
+  if (frame != FRAME_HANDLE_NONE && !framePoolRetain(frame)) return;
+
+  // Kesme sadece baştan çıkarır; pencere sürücüye verilmeden önce kaydı hazır olmalı
+  uint32_t primask = __get_PRIMASK();
+  __disable_irq();
+  uint8_t tail = (display_queue_head + display_queue_count) % DISPLAY_QUEUE_DEPTH;
+  display_queue[tail].frame = frame;
+  display_queue[tail].queued = frameTimestamp();
+  display_queue_count++;
+  __set_PRIMASK(primask);
+
+  if (LCD_Ioctl(command, param) != E_LCD_ERR_NONE) {
+    // Sürücüye girmedi, kesme bu kaydı görmeyecek
+    __disable_irq();
+    display_queue_count--;
+    __set_PRIMASK(primask);
+    framePoolRelease(frame);
+  }
+}
+
+static void displayQueueRegion(const ts_LCD_WR_TYPE *region, FrameHandle frame)
+{
+  displayQueue(E_LCD_IOCTL_QUEUE_REGION_DMA, (void *)region, frame);
+}
+
+// Kısmi çizim: sadece değişen dikdörtgenler yazılır. Kare genişliğinden en fazla
+// DISPLAY_ROW_COST_PIXELS dar olan dikdörtgen tam genişliğe açılır: satırları bellekte bitişik
+// olur ve tek DMA aktarımı gider, satır başına kesme ve yeniden başlatma kalkar. Aynı satırlara
+// düşen açılmış dikdörtgenler tek bantta birleşir, bandın kapsadığı dar dikdörtgen ayrıca yazılmaz.
+// LCD'ye giden piksel sayısını döner.
+static uint32_t displayQueueDamage(const FrameDescriptor *desc)
+{
+  uint16_t band_y1[DAMAGE_MAX_RECTS];
+  uint16_t band_y2[DAMAGE_MAX_RECTS];
+  int bands = 0;
+  uint32_t pixels = 0;
+  uint16_t *frame = framePoolData(desc->frame);
+
+  for (int i = 0; i < desc->damage.count; i++) {
+    const DamageRect *rect = &desc->damage.rects[i];
+    if (IMG_WIDTH - rect->width > DISPLAY_ROW_COST_PIXELS) continue;
+
+    // Çakışan veya bitişik bantlar birleşir; büyüyen bant öncekilere değebileceği için baştan bakılır
+    uint16_t y1 = rect->y;
+    uint16_t y2 = rect->y + rect->height - 1;
+    int b = 0;
+    while (b < bands) {
+      if (y1 <= band_y2[b] + 1 && band_y1[b] <= y2 + 1) {
+        if (band_y1[b] < y1) y1 = band_y1[b];
+        if (band_y2[b] > y2) y2 = band_y2[b];
+        bands--;
+        band_y1[b] = band_y1[bands];
+        band_y2[b] = band_y2[bands];
+        b = 0;
+      } else {
+        b++;
+      }
+    }
+    band_y1[bands] = y1;
+    band_y2[bands] = y2;
+    bands++;
+  }
+
+  for (int b = 0; b < bands; b++) {
+    ts_LCD_WR_TYPE region = {
+      .x1 = 0, .x2 = IMG_WIDTH - 1,
+      .y1 = band_y1[b], .y2 = band_y2[b],
+      .img = frame + (uint32_t)band_y1[b] * IMG_WIDTH,
+    };
+    displayQueueRegion(&region, desc->frame);
+    pixels += (uint32_t)(band_y2[b] - band_y1[b] + 1) * IMG_WIDTH;
+  }
+
+  for (int i = 0; i < desc->damage.count; i++) {
+    const DamageRect *rect = &desc->damage.rects[i];
+    bool covered = false;
+    for (int b = 0; b < bands && !covered; b++) {
+      covered = band_y1[b] <= rect->y && rect->y + rect->height - 1 <= band_y2[b];
+    }
+    if (covered) continue;
+
+    // Dar pencere: satırlar stride aralıklı, her satır ayrı DMA aktarımı
+    ts_LCD_WR_TYPE region = {
+      .x1 = rect->x, .x2 = rect->x + rect->width - 1,
+      .y1 = rect->y, .y2 = rect->y + rect->height - 1,
+      .img = frame + (uint32_t)rect->y * IMG_WIDTH + rect->x,
+      .stride = IMG_WIDTH,
+    };
+    displayQueueRegion(&region, desc->frame);
+    pixels += (uint32_t)rect->width * rect->height;
+  }
+  return pixels;
+}
+
+// Alarm overlay'i: tek renk, SDRAM okunmaz (DMA bellek adresini artırmaz)
+static void displayQueueOverlay(const FilterOverlay *overlay)
+{
+  ts_LCD_FILL_TYPE fill = {
+    .x1 = overlay->rect.x, .x2 = overlay->rect.x + overlay->rect.width - 1,
+    .y1 = overlay->rect.y, .y2 = overlay->rect.y + overlay->rect.height - 1,
+    .color = overlay->color,
+  };
+  displayQueue(E_LCD_IOCTL_QUEUE_FILL_RECT_DMA, &fill, FRAME_HANDLE_NONE);
+}
+
+// Sıradaki tüm pencereler LCD'ye yazılana kadar uyur
+static void displayQueueDrain(void)
+{
+  while (display_queue_count > 0) {
+    osThreadFlagsWait(DISPLAY_FLAG_LCD_DONE, osFlagsWaitAny, osWaitForever);
+  }
+}
+
+// SPI5 DMA kesmesinden: sıranın ilk penceresi gönderildi. Karesi bırakılır, DisplayTask uyandırılır.
+void LCD_TransferCompleteCallback(void)
+{
+  if (display_queue_count > 0) {
+    DisplayRegionSlot *slot = &display_queue[display_queue_head];
+    uint32_t now = frameTimestamp();
+    // Pencere sıraya girdiğinde SPI hâlâ öncekini gönderiyorsa süre onun bitişinden sayılır
+    uint32_t start = (int32_t)(display_queue_last_done - slot->queued) > 0 ? display_queue_last_done : slot->queued;
+
+    PROFILE_RECORD(PROFILE_PROBE_LCD, now - start);
+    display_lcd_cycles += now - start;
+    display_queue_last_done = now;
+    framePoolRelease(slot->frame);
+    display_queue_head = (display_queue_head + 1) % DISPLAY_QUEUE_DEPTH;
+    display_queue_count--;
+  }
+  osThreadFlagsSet(DisplayTaskHandle, DISPLAY_FLAG_LCD_DONE);
+}
+
+// Sürücülerin datasheet beklemeleri: kernel başladıktan sonra görev uyur, CPU diğer açılışa kalır
+void LCD_DelayMs(uint32_t ms)
+{
+  bootDelayMs(ms);
+}
+
+void Camera_DelayMs(uint32_t ms)
+{
+  bootDelayMs(ms);
+}
+
+// Profil dökümü SWO (ITM port 0) üzerinden, debugger'ın SWV konsolunda okunur
+static void profilerWriteITM(const char *text)
+{
+  while (*text) {
+    ITM_SendChar(*text++);
+  }
 }
 
 
@@ -927,8 +1205,8 @@ static void SDRAM_Initialization_Sequence(SDRAM_HandleTypeDef *hsdram, FMC_SDRAM
   /* Send the command */
   HAL_SDRAM_SendCommand(hsdram, Command, 0x1000);
 
-  /* Step 4: Insert 100 ms delay */
-  HAL_Delay(100);
+  /* Step 4: Insert the power-up delay */
+  HAL_Delay(SDRAM_POWERUP_DELAY_MS);
 
   /* Step 5: Configure a PALL (precharge all) command */
   Command->CommandMode 			 = FMC_SDRAM_CMD_PALL;
@@ -980,190 +1258,6 @@ static void Fill_Buffer(uint32_t *pBuffer, uint32_t uwBufferLenght, uint32_t uwO
   }
 }
 
-// Ana test fonksiyonu
-void runFilterTests(void) {
-    testGrayscaleFilter();
-    
-    testLaplacianFilter();
-    
-    testROIOptimization();
-    
-    testCenterROIAlarm();
-}
-
-// Test görüntüsü oluşturma
-static void createTestImage(uint16_t *image, int pattern) {
-    for (int y = 0; y < TEST_HEIGHT; y++) {
-        for (int x = 0; x < TEST_WIDTH; x++) {
-            switch (pattern) {
-                case 0: // Düz gri
-                    image[y * TEST_WIDTH + x] = 0x8410; // RGB565 format
-                    break;
-                case 1: // Dikey çizgiler
-                    image[y * TEST_WIDTH + x] = (x % 2) ? 0xFFFF : 0x0000;
-                    break;
-                case 2: // Yatay çizgiler
-                    image[y * TEST_WIDTH + x] = (y % 2) ? 0xFFFF : 0x0000;
-                    break;
-                case 3: // Dama tahtası
-                    image[y * TEST_WIDTH + x] = ((x + y) % 2) ? 0xFFFF : 0x0000;
-                    break;
-            }
-        }
-    }
-}
-
-// Test sonucu kontrolü
-static int compareImages(uint16_t *img1, uint16_t *img2, int size) {
-    int diff = 0;
-    for (int i = 0; i < size; i++) {
-        if (img1[i] != img2[i]) diff++;
-    }
-    return diff;
-}
-
-// Grayscale filtre testi
-static void testGrayscaleFilter(void) {
-    uint16_t input[TEST_WIDTH * TEST_HEIGHT];
-    uint16_t output[TEST_WIDTH * TEST_HEIGHT];
-    uint16_t expected[TEST_WIDTH * TEST_HEIGHT];
-    
-    // printf("Test: Grayscale Filtresi\n");
-    
-    // Test 1: Düz gri görüntü
-    createTestImage(input, 0);
-    memset(output, 0, sizeof(output));
-    applyFilterToImageFull(input, output, FILTER_GRAYSCALE);
-    
-    // Düz gri görüntü için çıktı aynı olmalı
-    int diff = compareImages(input, output, TEST_WIDTH * TEST_HEIGHT);
-    // printf("  Test 1 (Düz Gri): %s%s%s\n", 
-    //        diff == 0 ? ANSI_COLOR_GREEN : ANSI_COLOR_RED,
-    //        diff == 0 ? "BAŞARILI" : "BAŞARISIZ",
-    //        ANSI_COLOR_RESET);
-    
-    // Test 2: Siyah-beyaz dama tahtası
-    createTestImage(input, 3);
-    memset(output, 0, sizeof(output));
-    applyFilterToImageFull(input, output, FILTER_GRAYSCALE);
-    
-    grayscale_success = output[0] != input[0] ? 1 : 0;
-    // // Çıktıda gri tonları olmalı
-    // printf("  Test 2 (Dama Tahtası): %s%s%s\n",
-    //        output[0] != input[0] ? ANSI_COLOR_GREEN : ANSI_COLOR_RED,
-    //        output[0] != input[0] ? "BAŞARILI" : "BAŞARISIZ",
-    //        ANSI_COLOR_RESET);
-}
-
-// Laplacian filtre testi
-static void testLaplacianFilter(void) {
-    uint16_t input[TEST_WIDTH * TEST_HEIGHT];
-    uint16_t output[TEST_WIDTH * TEST_HEIGHT];
-    
-    // printf("Test: Laplacian Filtresi\n");
-    
-    // Test 1: Düz gri görüntü
-    createTestImage(input, 0);
-    memset(output, 0, sizeof(output));
-    applyFilterToImageFull(input, output, FILTER_LAPLACIAN);
-    
-    // Düz görüntüde kenar olmamalı
-    int edges = 0;
-    for (int i = 0; i < TEST_WIDTH * TEST_HEIGHT; i++) {
-        if (output[i] > 0x1000) edges++; // Belirgin kenar eşiği
-    }
-    
-    // printf("  Test 1 (Düz Gri): %s%s%s\n",
-    //        edges < TEST_WIDTH ? ANSI_COLOR_GREEN : ANSI_COLOR_RED,
-    //        edges < TEST_WIDTH ? "BAŞARILI" : "BAŞARISIZ",
-    //        ANSI_COLOR_RESET);
-    
-    // Test 2: Dikey çizgiler
-    createTestImage(input, 1);
-    memset(output, 0, sizeof(output));
-    applyFilterToImageFull(input, output, FILTER_LAPLACIAN);
-    
-    // Dikey kenarlarda yüksek değerler olmalı
-    edges = 0;
-    for (int i = 0; i < TEST_WIDTH * TEST_HEIGHT; i++) {
-        if (output[i] > 0x1000) edges++;
-    }
-    
-    laplacian_success = edges > TEST_WIDTH ? 1 : 0;
-    // printf("  Test 2 (Dikey Çizgiler): %s%s%s\n",
-    //        edges > TEST_WIDTH ? ANSI_COLOR_GREEN : ANSI_COLOR_RED,
-    //        edges > TEST_WIDTH ? "BAŞARILI" : "BAŞARISIZ",
-    //        ANSI_COLOR_RESET);
-}
-
-// ROI optimizasyon testi
-static void testROIOptimization(void) {
-    uint16_t input[TEST_WIDTH * TEST_HEIGHT];
-    uint16_t output1[TEST_WIDTH * TEST_HEIGHT];
-    uint16_t output2[TEST_WIDTH * TEST_HEIGHT];
-    
-    // printf("Test: ROI Optimizasyonu\n");
-    
-    // Test görüntüsü oluştur
-    createTestImage(input, 3);
-    
-    // ROI optimizasyonu kapalıyken işle
-    setROIOptimizationEnabled(false);
-    applyFilterToImageFull(input, output1, FILTER_LAPLACIAN);
-    
-    // ROI optimizasyonu açıkken işle
-    setROIOptimizationEnabled(true);
-    applyFilterToImageFull(input, output2, FILTER_LAPLACIAN);
-    
-    // Sonuçlar benzer olmalı (küçük farklılıklar olabilir)
-    int diff = compareImages(output1, output2, TEST_WIDTH * TEST_HEIGHT);
-    float diff_percent = (float)diff / (TEST_WIDTH * TEST_HEIGHT) * 100;
-    
-    roiopt_success = diff_percent < 10.0f ? 1 : 0;
-    // printf("  Test (Optimizasyon Karşılaştırma): %s%s%s\n",
-    //        diff_percent < 10.0f ? ANSI_COLOR_GREEN : ANSI_COLOR_RED,
-    //        diff_percent < 10.0f ? "BAŞARILI" : "BAŞARISIZ",
-    //        ANSI_COLOR_RESET);
-    // printf("  Farklılık: %.2f%%\n", diff_percent);
-}
-
-// Merkez ROI alarm testi
-static void testCenterROIAlarm(void) {
-    uint16_t input1[TEST_WIDTH * TEST_HEIGHT];
-    uint16_t input2[TEST_WIDTH * TEST_HEIGHT];
-    uint16_t output[TEST_WIDTH * TEST_HEIGHT];
-    
-    // printf("Test: Merkez ROI Alarm\n");
-    
-    // İlk kare: Düz gri
-    createTestImage(input1, 0);
-    memset(output, 0, sizeof(output));
-    applyFilterToImageFull(input1, output, FILTER_ROI_CENTER_ALARM);
-    
-    // İkinci kare: Dama tahtası (değişim yaratmak için)
-    createTestImage(input2, 3);
-    applyFilterToImageFull(input2, output, FILTER_ROI_CENTER_ALARM);
-    
-    // Merkez bölgede alarm rengi olmalı
-    int alarm_pixels = 0;
-    int center_y = TEST_HEIGHT / 2;
-    int center_x = TEST_WIDTH / 2;
-    
-    for (int y = center_y - CENTER_ROI_SIZE/2; y < center_y + CENTER_ROI_SIZE/2; y++) {
-        for (int x = center_x - CENTER_ROI_SIZE/2; x < center_x + CENTER_ROI_SIZE/2; x++) {
-            if (y >= 0 && y < TEST_HEIGHT && x >= 0 && x < TEST_WIDTH) {
-                if (output[y * TEST_WIDTH + x] == ALARM_COLOR) alarm_pixels++;
-            }
-        }
-    }
-    
-    roialarm_success = alarm_pixels > 0 ? 1 : 0;
-    // printf("  Test (Alarm Tetikleme): %s%s%s\n",
-    //        alarm_pixels > 0 ? ANSI_COLOR_GREEN : ANSI_COLOR_RED,
-    //        alarm_pixels > 0 ? "BAŞARILI" : "BAŞARISIZ",
-    //        ANSI_COLOR_RESET);
-}
- 
 /* USER CODE END 4 */
 
 /* USER CODE BEGIN Header_StartCameraTask */
@@ -1176,13 +1270,21 @@ static void testCenterROIAlarm(void) {
 void StartCameraTask(void *argument)
 {
   /* USER CODE BEGIN 5 */
-  /* Infinite loop */
-  for(;;)
-  {
-    osSemaphoreAcquire(sem_frame_capturedHandle, osWaitForever);
-    osThreadFlagsSet(FilterTaskHandle, 0x01);
-	  osDelay(10); // kamera hızı kadar beklenebilir
+  // SCCB yazmaları meşgul beklemeli I2C ile yapılır. Bu sürede DisplayTask'ın önceliğine inilir,
+  // LCD'nin reset beklemeleri bitince iki açılış CPU'yu zaman dilimleriyle paylaşır.
+  osThreadSetPriority(osThreadGetId(), osPriorityLow);
+  bootStageBegin(&boot_profile, BOOT_STAGE_CAMERA);
+  if (Camera_Open() != E_CAMERA_ERR_NONE) {
+    Error_Handler();
   }
+  bootStageEnd(&boot_profile, BOOT_STAGE_CAMERA);
+
+  // Yakalama çekirdek çalışırken başlar, DMA callback'i ilk kareden itibaren kuyruğa yazabilir.
+  // Sonrası kesmeyle yürür: kare hızını kamera belirler, filtre her zaman en yeni kareyi alır.
+  if (Camera_StartCapture(framePoolData(capture_frames[0]), framePoolData(capture_frames[1])) != E_CAMERA_ERR_NONE) {
+    Error_Handler();
+  }
+  osThreadExit();
   /* USER CODE END 5 */
 }
 
@@ -1196,11 +1298,88 @@ void StartCameraTask(void *argument)
 void StartDisplayTask(void *argument)
 {
   /* USER CODE BEGIN StartDisplayTask */
+  // Descriptor ~140 byte: görev stack'inde değil statik tutulur
+  static FrameDescriptor desc;
+  // Filtre şerit şerit gönderir: her descriptor'da sadece henüz çizilmemiş satırlar LCD sırasına
+  // eklenir. Görev şerit başına beklemez, SPI şeritleri arka arkaya gönderirken filtre sonrakini işler.
+  bool drawing = false;
+  uint32_t drawing_sequence = 0;
+  uint16_t rows_drawn = 0;
+  uint32_t display_enter = 0;
+  uint32_t lcd_cycles_start = 0; // Kare başındaki display_lcd_cycles
+  bool shown = false;            // Ekranda tamamı çizilmiş bir kare var
+  uint32_t shown_sequence = 0;   // O karenin sequence'i, kısmi çizim sadece ona göre yapılır
+
+  // Panel reset/sleep-out beklemelerinde görev uyur, kamera bu sırada ayarlanır
+  bootStageBegin(&boot_profile, BOOT_STAGE_LCD);
+  if (LCD_Open(NULL) != E_LCD_ERR_NONE) {
+    Error_Handler();
+  }
+  bootStageEnd(&boot_profile, BOOT_STAGE_LCD);
   /* Infinite loop */
   for(;;)
   {
-	osSemaphoreAcquire(sem_filter_doneHandle, osWaitForever);
-	LCD_Ioctl(E_LCD_IOCTL_DRAW_IMAGE, filtered_image);
+	if (!frameMailboxTake(&filtered_mailbox, &desc, osWaitForever)) continue;
+
+	// Yeni kare: önceki bitmediyse yarım kalır, yeni kare üstten çizilir
+	if (!drawing || desc.sequence != drawing_sequence) {
+	  drawing = true;
+	  drawing_sequence = desc.sequence;
+	  rows_drawn = 0;
+	  display_enter = frameTimestamp();
+	  lcd_cycles_start = display_lcd_cycles;
+	}
+
+	if (rows_drawn == 0 && desc.rows_ready >= IMG_HEIGHT &&
+	    filterOverlayCoversFrame(&desc.overlay, IMG_WIDTH, IMG_HEIGHT)) {
+	  // Overlay tüm kareyi kaplıyor (alarm başladı): kare yazılmamış, sadece dolgu gider
+	  display_pixels_last = 0;
+	  rows_drawn = IMG_HEIGHT;
+	} else if (rows_drawn == 0 && desc.rows_ready >= IMG_HEIGHT && !desc.damage.full &&
+	    shown && desc.damage_base == shown_sequence) {
+	  // Ekrandaki kareye göre sadece değişen pencereler yazılır, durağan sahne SPI'a yük olmaz
+	  display_pixels_last = displayQueueDamage(&desc);
+	  display_partial_count++;
+	  rows_drawn = IMG_HEIGHT;
+	} else if (desc.rows_ready > rows_drawn) {
+	  ts_LCD_WR_TYPE region = {
+	    .x1 = 0, .x2 = IMG_WIDTH - 1,
+	    .y1 = rows_drawn, .y2 = desc.rows_ready - 1,
+	    .img = framePoolData(desc.frame) + (uint32_t)rows_drawn * IMG_WIDTH,
+	  };
+	  displayQueueRegion(&region, desc.frame);
+	  display_pixels_last = (uint32_t)desc.rows_ready * IMG_WIDTH;
+	  rows_drawn = desc.rows_ready;
+	}
+
+	if (rows_drawn >= IMG_HEIGHT) {
+	  // Kare ancak son penceresi gidince ekrandadır. Filtre bu sırada sonraki karenin şeritlerini
+	  // işlemeye devam eder, onlar posta kutusunda bekler.
+	  if (desc.overlay.active) {
+	    displayQueueOverlay(&desc.overlay);
+	  }
+	  displayQueueDrain();
+	  uint32_t display_cycles = display_lcd_cycles - lcd_cycles_start;
+	  desc.stage_enter[FRAME_STAGE_DISPLAY] = display_enter;
+	  desc.stage_exit[FRAME_STAGE_DISPLAY] = frameTimestamp();
+	  recordDisplayedFrame(&desc);
+	  bootStageEnd(&boot_profile, BOOT_STAGE_FIRST_FRAME);
+	  drawing = false;
+	  // Overlay'li panel karenin kendisi değil, sonraki kare kısmi çizilemez
+	  shown = !desc.overlay.active;
+	  shown_sequence = desc.sequence;
+
+	  // Filtre + LCD süresi bütçeyi aşarsa kalite düşer; kamera hızı seviye değişince ayarlanır
+	  if (qualityControllerUpdate(&quality, desc.filter_type, desc.busy_cycles + display_cycles)) {
+	    Camera_SetCaptureRate(qualityHalvesCapture(quality.level) ? DCMI_CR_ALTERNATE_2_FRAME : DCMI_CR_ALL_FRAME);
+	  }
+	}
+	framePoolRelease(desc.frame);
+
+	if (profiler_dump_request) {
+	  profiler_dump_request = 0;
+	  profilerDump(profilerWriteITM);
+	}
   }
   /* USER CODE END StartDisplayTask */
 }
@@ -1215,12 +1394,172 @@ void StartDisplayTask(void *argument)
 void StartFilterTask(void *argument)
 {
   /* USER CODE BEGIN StartFilterTask */
+  // Filtrenin son çıkışı: ROI optimizasyonu değişmeyen blokları buradan alır, bu yüzden
+  // ekran bıraksa bile bir sonraki kareye kadar tutulur
+  FrameHandle last_output = FRAME_HANDLE_NONE;
+  uint32_t last_output_sequence = 0;   // Ekrana gönderilen son karenin sequence'i (damage_base)
+  // Descriptor'lar ~140 byte: görev stack'inde değil statik tutulur
+  static FrameDescriptor desc;
+  // İşlenen kare: giriş karesinin referansı ilk descriptor'dan tutulur, çıkış havuzdan alınır
+  static FrameDescriptor current = { .frame = FRAME_HANDLE_NONE };
+  static FrameDescriptor strip;
+  FrameHandle output = FRAME_HANDLE_NONE;
+  bool skipped = false;    // current.sequence atlandı (çıkış karesi yok veya kalite seviyesi gereği)
+  bool passthrough = false;
+  bool strip_mode = false;
+  uint16_t rows_out = 0;
+  uint32_t filter_start;
   /* Infinite loop */
   for(;;)
   {
-	osThreadFlagsWait(0x01, osFlagsWaitAny, osWaitForever);
-	applyFilterToImageFull(raw_image, filtered_image, filterType);
-	osSemaphoreRelease(sem_filter_doneHandle);
+	if (!frameMailboxTake(&captured_mailbox, &desc, osWaitForever)) continue;
+
+	if (desc.sequence == current.sequence &&
+	    (current.frame != FRAME_HANDLE_NONE || (skipped && desc.rows_ready < IMG_HEIGHT))) {
+	  // Aynı karenin yeni satırları. Atlanan kare tamamlanınca bir kez daha denenir.
+	  framePoolRelease(desc.frame);
+	  if (current.frame == FRAME_HANDLE_NONE) continue;
+	  if (desc.rows_ready < current.rows_ready) {
+	    // Satırlar geri gitti: kare baştan yazılıyor, işlenen satırlar artık geçersiz. Şerit ve kare
+	    // bırakılır; atlanan kare gibi sadece tamamlanınca bir kez daha denenir.
+	    framePoolRelease(current.frame);
+	    framePoolRelease(output);
+	    current.frame = FRAME_HANDLE_NONE;
+	    output = FRAME_HANDLE_NONE;
+	    skipped = true;
+	    filter_drop_count++;
+	    continue;
+	  }
+	  current.rows_ready = desc.rows_ready;
+	  current.stage_exit[FRAME_STAGE_CAPTURE] = desc.stage_exit[FRAME_STAGE_CAPTURE];
+	} else {
+	  // Yeni kare. Önceki bitmediyse bırakılır, en yeni kare kazanır.
+	  bool retry = skipped && desc.sequence == current.sequence;
+	  if (current.frame != FRAME_HANDLE_NONE) {
+	    framePoolRelease(current.frame);
+	    framePoolRelease(output);
+	    filter_drop_count++;
+	  }
+	  current = desc;
+	  current.stage_enter[FRAME_STAGE_FILTER] = frameTimestamp();
+	  current.filter_type = pipeline_config.filter_type;
+	  current.busy_cycles = 0;
+	  damageSetFull(&current.damage, IMG_WIDTH, IMG_HEIGHT);
+	  current.overlay.active = false;
+	  rows_out = 0;
+
+	  // Bütçe aşılıyorsa alternatif kareler hiç işlenmez (ekrana da gitmez)
+	  QualityLevel level = quality.level;
+	  if (qualitySkipsFrame(level, current.sequence)) {
+	    framePoolRelease(current.frame);
+	    current.frame = FRAME_HANDLE_NONE;
+	    if (!retry) quality_skip_count++;
+	    skipped = true;
+	    continue;
+	  }
+	  setFilterQuality(&display_filter, qualityFilterQuality(level));
+
+	  // Kimlik dönüşümü: çıkış karesi yok, yakalanan kare doğrudan ekrana gider (kopya yok)
+	  passthrough = filterPassthrough(&display_filter, current.filter_type);
+	  if (passthrough) {
+	    output = FRAME_HANDLE_NONE;
+	    skipped = false;
+	    strip_mode = false;
+	  } else {
+	    output = framePoolAcquire();
+	    skipped = output == FRAME_HANDLE_NONE;
+	    if (skipped) {
+	      framePoolRelease(current.frame);
+	      current.frame = FRAME_HANDLE_NONE;
+	      filter_drop_count++;
+	      continue;
+	    }
+
+	    // Nokta filtreleri ve kernel'ler şerit şerit, önceki kareye bakan filtreler kare sonunda
+	    ImageView raw_view = framePoolView(current.frame);
+	    ImageView filtered_view = framePoolView(output);
+	    strip_mode = filterStripBegin(&display_filter, &raw_view, &filtered_view, current.filter_type);
+	  }
+	}
+
+	bool complete = current.rows_ready >= IMG_HEIGHT;
+	bool alarm_was_active = display_filter.alarm_active;
+	uint32_t alarm_start_time = display_filter.alarm_start_time;
+
+	if (passthrough) {
+	  // Yakalanan satırlar olduğu gibi ekrana
+	  if (current.rows_ready > rows_out && !complete && framePoolRetain(current.frame)) {
+	    frameMailboxPost(&filtered_mailbox, &current);
+	  }
+	  rows_out = current.rows_ready;
+	} else if (strip_mode) {
+	  filter_start = frameTimestamp();
+	  uint16_t rows = filterStripProcess(&display_filter, current.rows_ready);
+	  current.busy_cycles += frameTimestamp() - filter_start;
+
+	  // Biten satırlar kare tamamlanmadan ekrana gider
+	  if (rows > rows_out && !complete && framePoolRetain(output)) {
+	    strip = current;
+	    strip.frame = output;
+	    strip.rows_ready = rows;
+	    frameMailboxPost(&filtered_mailbox, &strip);
+	  }
+	  rows_out = rows;
+	} else if (complete) {
+	  // Kare artık DMA slotunda değil, filtre sürerken üzerine yazılmaz
+	  ImageView raw_view = framePoolView(current.frame);
+	  ImageView filtered_view = framePoolView(output);
+	  filter_start = frameTimestamp();
+	  applyFilterToImageFull(&display_filter, &raw_view, &filtered_view, current.filter_type);
+	  current.busy_cycles += frameTimestamp() - filter_start;
+	  current.damage = display_filter.damage;
+	  current.overlay = display_filter.overlay;
+	}
+
+	if (!complete) continue;
+	PROFILE_RECORD(PROFILE_PROBE_FILTER + current.filter_type, current.busy_cycles);
+
+	// Bekleyen ayar komutları kareler arasında birlikte uygulanır. Yeni filtrenin geçmişi
+	// biten kareyle doldurulur, böylece ilk karesi "ilk kare" olarak harcanmaz.
+	PipelineConfig config = pipeline_config;
+	if (pipelineCommandApply(&pipeline_commands, &config)) {
+	  ImageView input_view = framePoolView(current.frame);
+	  setGaussianKernelSize(&display_filter, config.gaussian_size);
+	  setROIOptimizationEnabled(&display_filter, config.roi_optimization);
+	  filterPrime(&display_filter, &input_view, config.filter_type);
+	  pipeline_config = config;
+	}
+
+	if (passthrough) {
+	  // Giriş karesinin referansı ekrana devredilir, tutulacak çıkış yok
+	  framePoolRelease(last_output);
+	  last_output = FRAME_HANDLE_NONE;
+	} else {
+	  framePoolRelease(current.frame);
+	  current.frame = output;
+	  framePoolRelease(last_output);
+	  last_output = FRAME_HANDLE_NONE;
+	  // Alarm tüm kareyi overlay ile kapladıysa çıkış yazılmadı: ekrana gider ama tutulmaz
+	  if (!filterOverlayCoversFrame(&current.overlay, IMG_WIDTH, IMG_HEIGHT) && framePoolRetain(output)) {
+	    last_output = output;
+	  }
+	}
+	current.rows_ready = IMG_HEIGHT;
+	current.stage_exit[FRAME_STAGE_FILTER] = frameTimestamp();
+
+	// Alarm bu karede başladıysa hangi kare olduğu saklanır
+	if (display_filter.alarm_active &&
+	    (!alarm_was_active || display_filter.alarm_start_time != alarm_start_time)) {
+	  alarm_frame = current;
+	}
+
+	// Ekran bir önceki kareyi henüz almadıysa o kare düşürülür. Düşen karenin değişimleri
+	// kaybolacağı için damage_base ile ekran sadece bir önceki kareyi gösteriyorsa kısmi çizer.
+	current.damage_base = last_output_sequence;
+	last_output_sequence = current.sequence;
+	frameMailboxPost(&filtered_mailbox, &current);
+	current.frame = FRAME_HANDLE_NONE;
+	output = FRAME_HANDLE_NONE;
   }
   /* USER CODE END StartFilterTask */
 }
@@ -0,0 +1,78 @@
+#include "pipeline_command.h"
+
+bool pipelineCommandInit(PipelineCommandQueue *commands, const char *name) {
+    PipelineCommand stale;
+
+    if (commands->queue == NULL) {
+        osMessageQueueAttr_t attributes = { .name = name };
+        commands->queue = osMessageQueueNew(PIPELINE_COMMAND_QUEUE_LENGTH, sizeof(PipelineCommand), &attributes);
+        if (commands->queue == NULL) return false;
+    }
+
+    // Önceki çalışmadan kalan komutlar atılır
+    while (osMessageQueueGet(commands->queue, &stale, NULL, 0) == osOK) continue;
+    commands->posted = 0;
+    commands->dropped = 0;
+    commands->applied = 0;
+    return true;
+}
+
+bool pipelineCommandPost(PipelineCommandQueue *commands, PipelineCommandType type, int32_t value) {
+    PipelineCommand command = { .type = type, .value = value };
+
+    if (commands->queue == NULL || osMessageQueuePut(commands->queue, &command, 0, 0) != osOK) {
+        commands->dropped++;
+        return false;
+    }
+    commands->posted++;
+    return true;
+}
+
+FilterType pipelineNextFilter(FilterType filter_type) {
+    switch (filter_type) {
+        case FILTER_NONE:             return FILTER_GRAYSCALE;
+        case FILTER_GRAYSCALE:        return FILTER_LAPLACIAN;
+        case FILTER_LAPLACIAN:        return FILTER_GAUSSIAN;
+        case FILTER_GAUSSIAN:         return FILTER_ROI;
+        case FILTER_ROI:              return FILTER_ROI_CENTER_ALARM;
+        case FILTER_ROI_CENTER_ALARM: return FILTER_NONE;
+        default:                      return FILTER_NONE;
+    }
+}
+
+// Tek komutu uygular, geçersizse false
+static bool applyCommand(const PipelineCommand *command, PipelineConfig *config) {
+    switch (command->type) {
+        case PIPELINE_CMD_CYCLE_FILTER:
+            config->filter_type = pipelineNextFilter(config->filter_type);
+            return true;
+        case PIPELINE_CMD_SET_FILTER:
+            if (command->value < 0 || command->value >= FILTER_TYPE_COUNT) return false;
+            config->filter_type = (FilterType)command->value;
+            return true;
+        case PIPELINE_CMD_SET_GAUSSIAN_SIZE:
+            if (command->value != 3 && command->value != 5 && command->value != 7) return false;
+            config->gaussian_size = command->value;
+            return true;
+        case PIPELINE_CMD_SET_ROI_OPTIMIZATION:
+            config->roi_optimization = command->value != 0;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool pipelineCommandApply(PipelineCommandQueue *commands, PipelineConfig *config) {
+    PipelineConfig before = *config;
+    PipelineCommand command;
+
+    if (commands->queue == NULL) return false;
+
+    while (osMessageQueueGet(commands->queue, &command, NULL, 0) == osOK) {
+        if (applyCommand(&command, config)) commands->applied++;
+    }
+
+    return config->filter_type != before.filter_type ||
+           config->gaussian_size != before.gaussian_size ||
+           config->roi_optimization != before.roi_optimization;
+}
@@ -0,0 +1,94 @@
+#include "profiler.h"
+#include <stdio.h>
+#include <string.h>
+
+ProfilerState profiler_state;
+
+static const char *const probe_names[PROFILE_PROBE_COUNT] = {
+    [PROFILE_PROBE_CAPTURE] = "capture",
+    [PROFILE_PROBE_FILTER + FILTER_NONE] = "filter_none",
+    [PROFILE_PROBE_FILTER + FILTER_LAPLACIAN] = "filter_laplacian",
+    [PROFILE_PROBE_FILTER + FILTER_GAUSSIAN] = "filter_gaussian",
+    [PROFILE_PROBE_FILTER + FILTER_GRAYSCALE] = "filter_grayscale",
+    [PROFILE_PROBE_FILTER + FILTER_ROI] = "filter_roi",
+    [PROFILE_PROBE_FILTER + FILTER_ROI_CENTER_ALARM] = "filter_roi_alarm",
+    [PROFILE_PROBE_LCD] = "lcd_write",
+    [PROFILE_PROBE_GLASS] = "capture_to_glass",
+};
+
+void profilerInit(void) {
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    profilerReset();
+}
+
+void profilerReset(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    memset(&profiler_state, 0, sizeof(profiler_state));
+    for (int i = 0; i < PROFILE_PROBE_COUNT; i++) {
+        profiler_state.stats[i].min = UINT32_MAX;
+    }
+    __set_PRIMASK(primask);
+}
+
+void profilerRecord(ProfileProbe probe, uint32_t cycles) {
+    if ((unsigned)probe >= PROFILE_PROBE_COUNT) return;
+
+    // log2 kovası: 0 -> 0, [2^(k-1), 2^k) -> k
+    uint32_t bucket = cycles ? 32 - __CLZ(cycles) : 0;
+    if (bucket >= PROFILER_HIST_BUCKETS) bucket = PROFILER_HIST_BUCKETS - 1;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    ProfileStats *stats = &profiler_state.stats[probe];
+    stats->count++;
+    stats->sum += cycles;
+    if (cycles < stats->min) stats->min = cycles;
+    if (cycles > stats->max) stats->max = cycles;
+    stats->histogram[bucket]++;
+
+    ProfileSample *sample = &profiler_state.ring[profiler_state.ring_head % PROFILER_RING_SIZE];
+    sample->timestamp = profilerNow();
+    sample->cycles = cycles;
+    sample->probe = probe;
+    profiler_state.ring_head++;
+
+    __set_PRIMASK(primask);
+}
+
+uint32_t profilerMean(const ProfileStats *stats) {
+    return stats->count ? (uint32_t)(stats->sum / stats->count) : 0;
+}
+
+const char *profilerProbeName(ProfileProbe probe) {
+    return ((unsigned)probe < PROFILE_PROBE_COUNT && probe_names[probe]) ? probe_names[probe] : "?";
+}
+
+void profilerDump(ProfilerWriteFn write) {
+    static ProfileStats stats;  // Kopya: döküm sürerken kayıtlar devam edebilir
+    char line[96];
+
+    write("probe count min mean max (cycles)\r\n");
+    for (int probe = 0; probe < PROFILE_PROBE_COUNT; probe++) {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        stats = profiler_state.stats[probe];
+        __set_PRIMASK(primask);
+
+        if (stats.count == 0) continue;
+
+        snprintf(line, sizeof(line), "%s %lu %lu %lu %lu\r\n", profilerProbeName(probe),
+                 (unsigned long)stats.count, (unsigned long)stats.min,
+                 (unsigned long)profilerMean(&stats), (unsigned long)stats.max);
+        write(line);
+
+        // Boş olmayan kovalar: "<2^k:adet"
+        for (int bucket = 0; bucket < PROFILER_HIST_BUCKETS; bucket++) {
+            if (stats.histogram[bucket] == 0) continue;
+            snprintf(line, sizeof(line), "  <2^%d:%lu\r\n", bucket, (unsigned long)stats.histogram[bucket]);
+            write(line);
+        }
+    }
+}
@@ -0,0 +1,57 @@
+#include "quality_controller.h"
+
+void qualityControllerInit(QualityController *qc, uint32_t budget_cycles) {
+    qc->budget_cycles = budget_cycles;
+    qc->filter_type = FILTER_NONE;
+    qc->level_changes = 0;
+    qualityControllerReset(qc);
+}
+
+void qualityControllerReset(QualityController *qc) {
+    qc->level = QUALITY_LEVEL_FULL;
+    qc->over_count = 0;
+    qc->under_count = 0;
+    qc->last_cost = 0;
+}
+
+static void setLevel(QualityController *qc, QualityLevel level) {
+    qc->level = level;
+    qc->over_count = 0;
+    qc->under_count = 0;
+    qc->level_changes++;
+}
+
+bool qualityControllerUpdate(QualityController *qc, FilterType filter_type, uint32_t busy_cycles) {
+    QualityLevel level = qc->level;
+
+    // Yeni filtrenin maliyeti farklı, tam kaliteden başlayıp gerekirse hızla düşülür
+    if (filter_type != qc->filter_type) {
+        qc->filter_type = filter_type;
+        qualityControllerReset(qc);
+        if (level != QUALITY_LEVEL_FULL) qc->level_changes++;
+        return level != QUALITY_LEVEL_FULL;
+    }
+
+    uint32_t cost = busy_cycles / qualityFrameDivisor(level);
+    uint32_t recover_limit = (uint32_t)((uint64_t)qc->budget_cycles * QUALITY_RECOVER_PERCENT / 100);
+    qc->last_cost = cost;
+
+    if (cost > qc->budget_cycles) {
+        qc->under_count = 0;
+        if (++qc->over_count >= QUALITY_DEGRADE_FRAMES && level + 1 < QUALITY_LEVEL_COUNT) {
+            setLevel(qc, level + 1);
+            return true;
+        }
+    } else if (cost < recover_limit) {
+        qc->over_count = 0;
+        if (++qc->under_count >= QUALITY_RECOVER_FRAMES && level > QUALITY_LEVEL_FULL) {
+            setLevel(qc, level - 1);
+            return true;
+        }
+    } else {
+        // Bütçe içinde ama geri çıkacak kadar pay yok
+        qc->over_count = 0;
+        qc->under_count = 0;
+    }
+    return false;
+}
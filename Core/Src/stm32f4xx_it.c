@@ -24,7 +24,7 @@
 #include "task.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
-extern void cycleFilterType(void);
+
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -61,6 +61,7 @@ extern void cycleFilterType(void);
 extern DMA_HandleTypeDef hdma_dcmi;
 extern DCMI_HandleTypeDef hdcmi;
 /* USER CODE BEGIN EV */
+extern DMA_HandleTypeDef hdma_spi5_tx;
 
 /* USER CODE END EV */
 
@@ -216,11 +217,19 @@ void DCMI_IRQHandler(void)
 void EXTI0_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI0_IRQn 0 */
-  cycleFilterType();
+
   /* USER CODE END EXTI0_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(GPIO_PIN_0);
   /* USER CODE BEGIN EXTI0_IRQn 1 */
 
   /* USER CODE END EXTI0_IRQn 1 */
 }
+
+/**
+  * @brief This function handles DMA2 stream4 global interrupt (SPI5 TX, LCD pixels).
+  */
+void DMA2_Stream4_IRQHandler(void)
+{
+  HAL_DMA_IRQHandler(&hdma_spi5_tx);
+}
 /* USER CODE END 1 */
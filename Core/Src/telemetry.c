@@ -0,0 +1,98 @@
+#include "telemetry.h"
+#include <string.h>
+#include "stm32f4xx.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+TelemetryState telemetry_state;
+
+static osTimerId_t telemetry_timer;
+// uxTaskGetSystemState çıktısı, zamanlayıcı görevinin stack'inde yer kaplamasın
+static TaskStatus_t task_status[TELEMETRY_MAX_TASKS];
+
+void configureTimerForRunTimeStats(void) {
+    // Profiler ve kare zaman damgaları da aynı sayacı kullanır, burada sıfırlanmaz
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+unsigned long getRunTimeCounterValue(void) {
+    return DWT->CYCCNT;
+}
+
+static void telemetryTimerCallback(void *argument) {
+    (void)argument;
+    telemetrySample();
+}
+
+bool telemetryInit(void) {
+    static const osTimerAttr_t attributes = { .name = "telemetry" };
+
+    memset(&telemetry_state, 0, sizeof(telemetry_state));
+    telemetry_state.heap_free_min = UINT32_MAX;
+
+    if (telemetry_timer == NULL) {
+        telemetry_timer = osTimerNew(telemetryTimerCallback, osTimerPeriodic, NULL, &attributes);
+        if (telemetry_timer == NULL) return false;
+    }
+    return osTimerStart(telemetry_timer, TELEMETRY_PERIOD_MS) == osOK;
+}
+
+static TelemetryTask *findTask(const TaskStatus_t *status) {
+    TelemetryState *state = &telemetry_state;
+
+    for (int i = 0; i < state->task_count; i++) {
+        if (state->tasks[i].task_number == status->xTaskNumber) return &state->tasks[i];
+    }
+    if (state->task_count == TELEMETRY_MAX_TASKS) return NULL;
+
+    TelemetryTask *task = &state->tasks[state->task_count++];
+    strncpy(task->name, status->pcTaskName, sizeof(task->name) - 1);
+    task->task_number = status->xTaskNumber;
+    task->stack_free_min = UINT32_MAX;
+    task->run_time = 0;     // Sayaç görev oluşturulunca 0'dan başlar
+    return task;
+}
+
+static uint16_t permille(uint32_t part, uint32_t total) {
+    if (total == 0) return 0;
+    uint64_t value = (uint64_t)part * 1000 / total;
+    return value > 1000 ? 1000 : (uint16_t)value;
+}
+
+void telemetrySample(void) {
+    TelemetryState *state = &telemetry_state;
+    uint32_t total_run_time;
+    UBaseType_t count = uxTaskGetSystemState(task_status, TELEMETRY_MAX_TASKS, &total_run_time);
+    // Sayaçlar uint32_t taşmasıyla döner, farklar periyot ~23 s'den kısa oldukça doğru
+    uint32_t elapsed = total_run_time - state->total_run_time;
+
+    for (int i = 0; i < state->task_count; i++) {
+        state->tasks[i].alive = false;
+    }
+
+    for (UBaseType_t i = 0; i < count; i++) {
+        const TaskStatus_t *status = &task_status[i];
+        TelemetryTask *task = findTask(status);
+        if (task == NULL) continue;
+
+        uint32_t stack_free = (uint32_t)status->usStackHighWaterMark * sizeof(StackType_t);
+        if (stack_free < task->stack_free_min) task->stack_free_min = stack_free;
+
+        task->cpu_permille = permille(status->ulRunTimeCounter - task->run_time, elapsed);
+        if (task->cpu_permille > task->cpu_permille_max) task->cpu_permille_max = task->cpu_permille;
+        task->run_time = status->ulRunTimeCounter;
+        task->alive = true;
+
+        if (strcmp(status->pcTaskName, "IDLE") == 0) {    // tasks.c configIDLE_TASK_NAME
+            state->cpu_load_permille = 1000 - task->cpu_permille;
+            if (state->cpu_load_permille > state->cpu_load_permille_max) {
+                state->cpu_load_permille_max = state->cpu_load_permille;
+            }
+        }
+    }
+
+    state->heap_free_min = xPortGetMinimumEverFreeHeapSize();
+    state->total_run_time = total_run_time;
+    state->samples++;
+}
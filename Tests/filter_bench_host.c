@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "filter.h"
+#include "luma.h"
+
+// applyFilterToImageFull'ın host'ta kare başına süresi, her filtre için 320x240.
+// Sahne gürültülü bir arka plan üzerinde kayan beyaz bir kutudur, böylece ROI yolları da iş yapar.
+// Süreler host CPU'suna aittir; hedefteki bütçe için değil, değişiklikleri kıyaslamak içindir.
+// Argüman: ölçülen kare sayısı (varsayılan BENCH_DEFAULT_FRAMES).
+#define BENCH_WIDTH          320
+#define BENCH_HEIGHT         240
+#define BENCH_DEFAULT_FRAMES 200
+#define BENCH_WARMUP_FRAMES  2
+#define BENCH_BOX_SIZE       32
+#define BENCH_BOX_STEP       4    // Kare başına kayma (piksel)
+
+typedef struct {
+    const char *name;
+    FilterType filter;
+    int gaussian_size;
+    bool roi_optimization;
+} BenchCase;
+
+static const BenchCase bench_cases[] = {
+    { "none",              FILTER_NONE,             3, false },
+    { "grayscale",         FILTER_GRAYSCALE,        3, false },
+    { "laplacian",         FILTER_LAPLACIAN,        3, false },
+    { "laplacian_roi_opt", FILTER_LAPLACIAN,        3, true  },
+    { "gaussian3",         FILTER_GAUSSIAN,         3, false },
+    { "gaussian5",         FILTER_GAUSSIAN,         5, false },
+    { "gaussian7",         FILTER_GAUSSIAN,         7, false },
+    { "roi",               FILTER_ROI,              3, false },
+    { "roi_center_alarm",  FILTER_ROI_CENTER_ALARM, 3, false },
+};
+
+static uint16_t background[BENCH_WIDTH * BENCH_HEIGHT];
+static uint16_t frames[2][BENCH_WIDTH * BENCH_HEIGHT];
+static uint16_t output[BENCH_WIDTH * BENCH_HEIGHT];
+static uint8_t luma_planes[2][BENCH_WIDTH * BENCH_HEIGHT];
+static FilterContext ctx;
+
+// Arka plan + kare numarasına göre kaymış beyaz kutu
+static void renderScene(uint16_t *dst, uint32_t frame) {
+    int span = BENCH_WIDTH - BENCH_BOX_SIZE;
+    int x0 = (int)((frame * BENCH_BOX_STEP) % (uint32_t)span);
+    int y0 = (BENCH_HEIGHT - BENCH_BOX_SIZE) / 2;
+
+    for (int i = 0; i < BENCH_WIDTH * BENCH_HEIGHT; i++) dst[i] = background[i];
+    for (int y = y0; y < y0 + BENCH_BOX_SIZE; y++) {
+        for (int x = x0; x < x0 + BENCH_BOX_SIZE; x++) dst[y * BENCH_WIDTH + x] = 0xFFFF;
+    }
+}
+
+static double elapsedMs(const struct timespec *start, const struct timespec *end) {
+    return (end->tv_sec - start->tv_sec) * 1e3 + (end->tv_nsec - start->tv_nsec) / 1e6;
+}
+
+int main(int argc, char **argv) {
+    int frame_count = (argc > 1) ? atoi(argv[1]) : BENCH_DEFAULT_FRAMES;
+    uint32_t seed = 0x12345678;
+
+    if (frame_count <= 0) {
+        printf("usage: %s [frames]\n", argv[0]);
+        return 1;
+    }
+
+    initLumaTables();
+    for (int i = 0; i < BENCH_WIDTH * BENCH_HEIGHT; i++) {
+        seed = seed * 1664525 + 1013904223;
+        background[i] = (uint16_t)(seed >> 16) & 0x39E7;  // Koyu, düşük genlikli gürültü
+    }
+
+    ImageView out = imageViewMake(output, BENCH_WIDTH, BENCH_HEIGHT, IMAGE_FORMAT_RGB565);
+
+    printf("%-18s %10s  (%dx%d, %d frames)\n", "filter", "ms/frame", BENCH_WIDTH, BENCH_HEIGHT, frame_count);
+    for (uint32_t c = 0; c < sizeof(bench_cases) / sizeof(bench_cases[0]); c++) {
+        const BenchCase *bench = &bench_cases[c];
+        double total_ms = 0;
+
+        filterContextInit(&ctx, luma_planes[0], sizeof(luma_planes[0]), 2);
+        setGaussianKernelSize(&ctx, bench->gaussian_size);
+        setROIOptimizationEnabled(&ctx, bench->roi_optimization);
+
+        // Sahneyi çizmek ölçülmez, sadece filtre çağrısı
+        for (uint32_t f = 0; f < BENCH_WARMUP_FRAMES + (uint32_t)frame_count; f++) {
+            ImageView in = imageViewMake(frames[f & 1], BENCH_WIDTH, BENCH_HEIGHT, IMAGE_FORMAT_RGB565);
+            struct timespec start, end;
+
+            renderScene(frames[f & 1], f);
+            clock_gettime(CLOCK_MONOTONIC, &start);
+            applyFilterToImageFull(&ctx, &in, &out, bench->filter);
+            clock_gettime(CLOCK_MONOTONIC, &end);
+            if (f >= BENCH_WARMUP_FRAMES) total_ms += elapsedMs(&start, &end);
+        }
+
+        printf("%-18s %10.3f\n", bench->name, total_ms / frame_count);
+    }
+    return 0;
+}
@@ -0,0 +1,37 @@
+#include <stdio.h>
+#include <string.h>
+#include "filter_tests.h"
+#include "frame_pool.h"
+#include "luma.h"
+
+// Hedefteki runFilterTests() testlerini host'ta çalıştırır.
+// Argümansız: tüm sonuçları yazar, başarısız test sayısını döner.
+// Test adıyla: sadece o sonucu döner (0 başarılı, 1 başarısız, 77 atlandı; ctest SKIP_RETURN_CODE).
+#define HOST_TEST_SKIP_CODE 77
+
+int main(int argc, char **argv) {
+    int failures = 0;
+
+    initLumaTables();
+    framePoolInit();
+    runFilterTests();
+
+    for (uint32_t i = 0; i < filter_test_result_count; i++) {
+        const FilterTestResult *test = &filter_test_results[i];
+        uint8_t result = *test->result;
+
+        if (argc > 1) {
+            if (strcmp(argv[1], test->name) != 0) continue;
+            printf("%s: %s\n", test->name, result == TEST_SKIPPED ? "SKIPPED" : result ? "PASSED" : "FAILED");
+            return result == TEST_SKIPPED ? HOST_TEST_SKIP_CODE : result ? 0 : 1;
+        }
+        printf("%-18s %s\n", test->name, result == TEST_SKIPPED ? "SKIPPED" : result ? "PASSED" : "FAILED");
+        failures += result == 0;
+    }
+
+    if (argc > 1) {
+        printf("unknown test: %s\n", argv[1]);
+        return 1;
+    }
+    return failures;
+}
@@ -0,0 +1,8 @@
+#ifndef CAMERA_DRV_STUB_H
+#define CAMERA_DRV_STUB_H
+
+// Host testleri için: kare pool'u sadece görüntü boyutlarına ihtiyaç duyar.
+#define IMG_WIDTH   320
+#define IMG_HEIGHT  240
+
+#endif /* CAMERA_DRV_STUB_H */
@@ -0,0 +1,96 @@
+#ifndef CMSIS_OS_STUB_H
+#define CMSIS_OS_STUB_H
+
+// Host testleri için CMSIS-RTOS2 yerine geçen tek görevli stub.
+// Kuyruk ve semaforlar bloklamaz: boşsa/doluysa hemen osErrorResource döner.
+// Kernel hiç çalışmıyor görünür, tick sayacı 0'da kalır.
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define osWaitForever       0xFFFFFFFFU
+#define portTICK_PERIOD_MS  1
+
+typedef enum {
+    osOK = 0,
+    osErrorResource = -3,
+    osErrorParameter = -4
+} osStatus_t;
+
+typedef enum {
+    osKernelInactive = 1,
+    osKernelRunning = 2
+} osKernelState_t;
+
+static inline osKernelState_t osKernelGetState(void) { return osKernelInactive; }
+static inline uint32_t osKernelGetTickCount(void) { return 0; }
+static inline osStatus_t osDelay(uint32_t ticks) { (void)ticks; return osOK; }
+
+typedef struct { const char *name; } osMessageQueueAttr_t;
+typedef struct {
+    uint32_t capacity, count, head, msg_size;
+    uint8_t *data;
+} osMessageQueueStub;
+typedef osMessageQueueStub *osMessageQueueId_t;
+
+static inline osMessageQueueId_t osMessageQueueNew(uint32_t msg_count, uint32_t msg_size, const osMessageQueueAttr_t *attr) {
+    (void)attr;
+    osMessageQueueStub *queue = calloc(1, sizeof(osMessageQueueStub));
+    if (queue == NULL) return NULL;
+    queue->data = calloc(msg_count, msg_size);
+    queue->capacity = msg_count;
+    queue->msg_size = msg_size;
+    return queue;
+}
+
+static inline osStatus_t osMessageQueuePut(osMessageQueueId_t queue, const void *msg, uint8_t prio, uint32_t timeout) {
+    (void)prio; (void)timeout;
+    if (queue == NULL) return osErrorParameter;
+    if (queue->count == queue->capacity) return osErrorResource;
+    memcpy(&queue->data[((queue->head + queue->count) % queue->capacity) * queue->msg_size], msg, queue->msg_size);
+    queue->count++;
+    return osOK;
+}
+
+static inline osStatus_t osMessageQueueGet(osMessageQueueId_t queue, void *msg, uint8_t *prio, uint32_t timeout) {
+    (void)prio; (void)timeout;
+    if (queue == NULL) return osErrorParameter;
+    if (queue->count == 0) return osErrorResource;
+    memcpy(msg, &queue->data[queue->head * queue->msg_size], queue->msg_size);
+    queue->head = (queue->head + 1) % queue->capacity;
+    queue->count--;
+    return osOK;
+}
+
+static inline uint32_t osMessageQueueGetCount(osMessageQueueId_t queue) { return queue ? queue->count : 0; }
+
+typedef struct { const char *name; } osSemaphoreAttr_t;
+typedef struct { uint32_t max_count, count; } osSemaphoreStub;
+typedef osSemaphoreStub *osSemaphoreId_t;
+
+static inline osSemaphoreId_t osSemaphoreNew(uint32_t max_count, uint32_t initial_count, const osSemaphoreAttr_t *attr) {
+    (void)attr;
+    osSemaphoreStub *semaphore = calloc(1, sizeof(osSemaphoreStub));
+    if (semaphore == NULL) return NULL;
+    semaphore->max_count = max_count;
+    semaphore->count = initial_count;
+    return semaphore;
+}
+
+static inline osStatus_t osSemaphoreAcquire(osSemaphoreId_t semaphore, uint32_t timeout) {
+    (void)timeout;
+    if (semaphore == NULL) return osErrorParameter;
+    if (semaphore->count == 0) return osErrorResource;
+    semaphore->count--;
+    return osOK;
+}
+
+static inline osStatus_t osSemaphoreRelease(osSemaphoreId_t semaphore) {
+    if (semaphore == NULL) return osErrorParameter;
+    if (semaphore->count >= semaphore->max_count) return osErrorResource;
+    semaphore->count++;
+    return osOK;
+}
+
+#endif /* CMSIS_OS_STUB_H */
@@ -0,0 +1,6 @@
+#ifndef MAIN_STUB_H
+#define MAIN_STUB_H
+
+// Host testleri için boş main.h: SDRAM_BANK_ADDR tanımsız, kare pool'u normal bellekte.
+
+#endif /* MAIN_STUB_H */
@@ -0,0 +1,87 @@
+#ifndef STM32F4XX_STUB_H
+#define STM32F4XX_STUB_H
+
+// Host testleri için CMSIS çekirdek stub'ı: PRIMASK bir değişken, DWT döngü sayacı her
+// okumada ilerler. Filtre çekirdeklerinin _dsp sürümleri de host'ta derlendiği için
+// kullandıkları SIMD intrinsic'lerinin taşınabilir C karşılıkları aşağıda.
+
+#include <stdint.h>
+#include <string.h>
+
+static __attribute__((unused)) uint32_t stub_primask;
+static inline uint32_t __get_PRIMASK(void) { return stub_primask; }
+static inline void __set_PRIMASK(uint32_t primask) { stub_primask = primask; }
+static inline void __disable_irq(void) { stub_primask = 1; }
+static inline uint32_t __CLZ(uint32_t value) { return value ? (uint32_t)__builtin_clz(value) : 32; }
+
+typedef struct {
+    uint32_t CTRL;
+    uint32_t CYCCNT;
+} DWT_Type;
+static __attribute__((unused)) DWT_Type stub_dwt;
+static inline DWT_Type *stubDwtRead(void) {
+    stub_dwt.CYCCNT += 16;
+    return &stub_dwt;
+}
+#define DWT (stubDwtRead())
+#define DWT_CTRL_CYCCNTENA_Msk 1U
+
+typedef struct {
+    uint32_t DEMCR;
+} CoreDebug_Type;
+static __attribute__((unused)) CoreDebug_Type stub_core_debug;
+#define CoreDebug (&stub_core_debug)
+#define CoreDebug_DEMCR_TRCENA_Msk 1U
+
+// SIMD intrinsic'leri: bayt/halfword şeritleri tek tek hesaplanır.
+// __USUB8 APSR.GE bayraklarını stub_ge'ye yazar, __SEL onları okur.
+static __attribute__((unused)) uint32_t stub_ge;
+
+static inline uint32_t __UNALIGNED_UINT32_READ(const void *ptr) {
+    uint32_t value;
+    memcpy(&value, ptr, sizeof(value));
+    return value;
+}
+#define __UNALIGNED_UINT32_WRITE(ptr, value) \
+    do { uint32_t stub_value_ = (value); memcpy((ptr), &stub_value_, sizeof(stub_value_)); } while (0)
+
+static inline uint32_t __SMLAD(uint32_t op1, uint32_t op2, uint32_t acc) {
+    return acc + (uint32_t)((int32_t)(int16_t)op1 * (int16_t)op2)
+               + (uint32_t)((int32_t)(int16_t)(op1 >> 16) * (int16_t)(op2 >> 16));
+}
+#define __PKHBT(arg1, arg2, shift) ((((uint32_t)(arg1)) & 0x0000FFFFU) | ((((uint32_t)(arg2)) << (shift)) & 0xFFFF0000U))
+#define __PKHTB(arg1, arg2, shift) ((((uint32_t)(arg1)) & 0xFFFF0000U) | ((((uint32_t)(arg2)) >> (shift)) & 0x0000FFFFU))
+
+static inline uint32_t __USUB8(uint32_t op1, uint32_t op2) {
+    uint32_t result = 0;
+    stub_ge = 0;
+    for (int lane = 0; lane < 4; lane++) {
+        int a = (op1 >> (8 * lane)) & 0xFF;
+        int b = (op2 >> (8 * lane)) & 0xFF;
+        if (a >= b) stub_ge |= 1U << lane;
+        result |= (uint32_t)((a - b) & 0xFF) << (8 * lane);
+    }
+    return result;
+}
+
+static inline uint32_t __SEL(uint32_t op1, uint32_t op2) {
+    uint32_t result = 0;
+    for (int lane = 0; lane < 4; lane++) {
+        uint32_t mask = 0xFFU << (8 * lane);
+        result |= ((stub_ge >> lane) & 1U) ? (op1 & mask) : (op2 & mask);
+    }
+    return result;
+}
+
+static inline uint32_t __USADA8(uint32_t op1, uint32_t op2, uint32_t acc) {
+    for (int lane = 0; lane < 4; lane++) {
+        int a = (op1 >> (8 * lane)) & 0xFF;
+        int b = (op2 >> (8 * lane)) & 0xFF;
+        acc += (uint32_t)(a > b ? a - b : b - a);
+    }
+    return acc;
+}
+
+static __attribute__((unused)) uint32_t SystemCoreClock = 180000000U;
+
+#endif /* STM32F4XX_STUB_H */
@@ -0,0 +1,11 @@
+#ifndef STM32F4XX_HAL_STUB_H
+#define STM32F4XX_HAL_STUB_H
+
+// Host testleri için HAL stub'ı: tick 0'da kalır, beklemeler anında döner.
+
+#include "stm32f4xx.h"
+
+static inline uint32_t HAL_GetTick(void) { return 0; }
+static inline void HAL_Delay(uint32_t ms) { (void)ms; }
+
+#endif /* STM32F4XX_HAL_STUB_H */